@@ -153,3 +153,8 @@ group ""
 
 include "custom_engine/premake5.lua"
 include "sandbox/premake5.lua"
+
+group "tools"
+include "asset_cooker/premake5.lua"
+include "engine_tests/premake5.lua"
+group ""
@@ -0,0 +1,27 @@
+project "asset_cooker"
+	kind "ConsoleApp"
+	language "C++"
+	cdialect "C11"
+	cppdialect "C++17"
+	characterset ("ASCII") -- Default, Unicode, MBCS, ASCII
+
+	cooker_to_root = path.getrelative(os.getcwd(), root_directory)
+	targetdir (cooker_to_root .. "/" .. target_location .. "/%{prj.name}")
+	objdir (cooker_to_root .. "/" .. intermediate_location .. "/%{prj.name}")
+	implibdir (cooker_to_root .. "/" .. intermediate_location .. "/%{prj.name}")
+
+	debugdir ("%{cfg.targetdir}")
+
+	files {
+		"src/**.h",
+		"src/**.cpp",
+	}
+
+	includedirs {
+		cooker_to_root .. "/custom_engine/%{engine_includes.custom_engine}",
+		cooker_to_root .. "/custom_engine/%{engine_includes.lua}",
+	}
+
+	links {
+		"custom_engine",
+	}
@@ -0,0 +1,253 @@
+#include "custom_engine.h"
+
+#include "engine/core/lz4.h"
+#include "engine/api/internal/asset_pack.h"
+#include "engine/impl/array.h"
+#include "engine/impl/bytecode.h"
+
+#if !defined(CUSTOM_PRECOMPILED_HEADER)
+	#include <Windows.h>
+	#include <stdio.h>
+	#include <stdlib.h>
+	#include <string.h>
+#endif
+
+// @Note: cooks source assets in place into a load-ready binary form, see `Cooked_Header`;
+//        runs over a build's assets directory, so sources stay intact in the repository;
+//        configs, prefabs, scripts and shaders are left as text
+
+typedef bool cook_func(custom::file::View file, custom::Bytecode & bc);
+
+// @Note: the same checks the runtime decoders make; an invalid asset isn't cooked
+static bool is_valid(custom::Texture_Asset const & asset)    { return asset.data.data; }
+static bool is_valid(custom::Mesh_Asset const & asset)       { return asset.buffers.count; }
+static bool is_valid(custom::Collider2d_Asset const & asset) { return asset.points.count; }
+
+template<typename T>
+static bool cook_asset(custom::file::View file, custom::Bytecode & bc) {
+	T asset = {};
+	asset.update(file);
+	if (!is_valid(asset)) { return false; }
+	asset.cook(bc);
+	return true;
+}
+
+struct Cooker {
+	cstring     extension;
+	cook_func * cook;
+};
+
+static Cooker const cookers[] = {
+	{".png",      &cook_asset<custom::Texture_Asset>},
+	{".obj",      &cook_asset<custom::Mesh_Asset>},
+	{".collider", &cook_asset<custom::Collider2d_Asset>},
+};
+
+static u32 cooked_count;
+static u32 failed_count;
+
+// @Note: pack paths are relative to the parent of the assets directory, as asset paths are
+static custom::Array<char> pack_prefix;
+static custom::Array<char> pack_paths; // zero-terminated files to pack
+
+static cook_func * find_cooker(cstring path) {
+	u32 path_length = (u32)strlen(path);
+	for (u32 i = 0; i < C_ARRAY_LENGTH(cookers); ++i) {
+		u32 length = (u32)strlen(cookers[i].extension);
+		if (path_length < length) { continue; }
+		if (strcmp(path + path_length - length, cookers[i].extension) != 0) { continue; }
+		return cookers[i].cook;
+	}
+	return NULL;
+}
+
+static bool write_file(cstring path, custom::Array<u8> const & buffer) {
+	FILE * file = fopen(path, "wb");
+	if (!file) { return false; }
+	size_t written = fwrite(buffer.data, sizeof(u8), buffer.count, file);
+	fclose(file);
+	return written == buffer.count;
+}
+
+static void cook_file(cstring path, cook_func * cook) {
+	custom::Array<u8> file;
+	if (!custom::file::read(path, file)) {
+		printf("failed to read: '%s'\n", path);
+		++failed_count; return;
+	}
+
+	// @Note: a cooked file starts with a zero byte; no text or PNG one does
+	if (file.count >= sizeof(custom::Cooked_Header) && file.data[0] == 0) { return; }
+
+	file.push('\0'); --file.count;
+
+	// @Note: the source is left intact, so that a fixed importer can try again
+	custom::Bytecode bc;
+	if (!(*cook)({file.data, file.count}, bc)) {
+		printf("failed to cook: '%s'\n", path);
+		++failed_count; return;
+	}
+	if (!write_file(path, bc.buffer)) {
+		printf("failed to write: '%s'\n", path);
+		++failed_count; return;
+	}
+
+	printf("cooked: '%s'\n", path);
+	++cooked_count;
+}
+
+static void cook_directory(cstring path) {
+	custom::Array<char> mask;
+	mask.push_range(path, (u32)strlen(path));
+	mask.push_range("/*", 3);
+
+	WIN32_FIND_DATA find_data;
+	HANDLE handle = FindFirstFile(mask.data, &find_data);
+	if (handle == INVALID_HANDLE_VALUE) {
+		printf("failed to open: '%s'\n", path);
+		++failed_count; return;
+	}
+
+	custom::Array<char> child;
+	do {
+		if (strcmp(find_data.cFileName, ".") == 0) { continue; }
+		if (strcmp(find_data.cFileName, "..") == 0) { continue; }
+
+		child.count = 0;
+		child.push_range(path, (u32)strlen(path));
+		child.push('/');
+		child.push_range(find_data.cFileName, (u32)strlen(find_data.cFileName) + 1);
+
+		if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+			cook_directory(child.data);
+			continue;
+		}
+
+		cook_func * cook = find_cooker(child.data);
+		if (cook) { cook_file(child.data, cook); }
+
+		pack_paths.push_range(child.data, child.count);
+	} while (FindNextFile(handle, &find_data));
+
+	FindClose(handle);
+}
+
+//
+// pack
+//
+
+static int compare_entries(void const * a, void const * b) {
+	u32 hash_a = ((custom::pack::Entry const *)a)->hash;
+	u32 hash_b = ((custom::pack::Entry const *)b)->hash;
+	return (hash_a > hash_b) - (hash_a < hash_b);
+}
+
+static void pad_to_alignment(custom::Array<u8> & buffer) {
+	while (buffer.count % custom::pack::alignment) { buffer.push(0); }
+}
+
+static void write_pack(cstring path, u32 root_length) {
+	custom::Array<custom::pack::Entry> entries;
+	custom::Array<char> paths;
+	custom::Array<u8> data;
+	custom::Array<u8> file;
+	custom::Array<u8> packed;
+
+	u32 stored_count = 0;
+	for (cstring file_path = pack_paths.data; file_path < pack_paths.data + pack_paths.count; file_path += strlen(file_path) + 1) {
+		if (!custom::file::read(file_path, file)) {
+			printf("failed to read: '%s'\n", file_path);
+			++failed_count; continue;
+		}
+
+		u32 path_offset = paths.count;
+		paths.push_range(pack_prefix.data, pack_prefix.count);
+		paths.push_range(file_path + root_length, (u32)strlen(file_path + root_length) + 1);
+
+		// @Note: compression pays off only if it saves a quarter at least,
+		//        otherwise a zero-copy view is preferable
+		packed.set_capacity(custom::lz4::get_bound(file.count));
+		packed.count = file.count ? custom::lz4::compress(file.data, file.count, packed.data) : 0;
+		bool is_stored = (packed.count >= file.count - file.count / 4);
+
+		pad_to_alignment(data);
+		custom::pack::Entry entry;
+		entry.hash         = custom::pack::hash_path(paths.data + path_offset);
+		entry.path         = path_offset;
+		entry.offset       = data.count;
+		entry.count        = file.count;
+		entry.packed_count = is_stored ? file.count : packed.count;
+		entries.push(entry);
+
+		if (is_stored) {
+			data.push_range(file.data, file.count);
+			data.push('\0');
+			++stored_count;
+		}
+		else {
+			data.push_range(packed.data, packed.count);
+		}
+	}
+
+	qsort(entries.data, entries.count, sizeof(*entries.data), &compare_entries);
+
+	// @Note: align data to the start of the file
+	custom::pack::Header header = {custom::pack::magic, custom::pack::version, entries.count, paths.count};
+	u64 data_offset = sizeof(header) + (u64)entries.count * sizeof(*entries.data) + paths.count;
+	u32 padding = (u32)(CUSTOM_ALIGN(data_offset, (u64)custom::pack::alignment) - data_offset);
+	data_offset += padding;
+	for (u32 i = 0; i < entries.count; ++i) {
+		entries[i].offset += data_offset;
+	}
+
+	u8 const zeroes[custom::pack::alignment] = {};
+	FILE * pack = fopen(path, "wb");
+	if (!pack) {
+		printf("failed to write: '%s'\n", path);
+		++failed_count; return;
+	}
+	fwrite(&header, sizeof(header), 1, pack);
+	fwrite(entries.data, sizeof(*entries.data), entries.count, pack);
+	fwrite(paths.data, sizeof(*paths.data), paths.count, pack);
+	fwrite(zeroes, sizeof(*zeroes), padding, pack);
+	fwrite(data.data, sizeof(*data.data), data.count, pack);
+	bool is_written = !ferror(pack);
+	fclose(pack);
+
+	if (!is_written) {
+		printf("failed to write: '%s'\n", path);
+		++failed_count; return;
+	}
+
+	printf("packed: '%s', %u entries, %u compressed\n", path, entries.count, entries.count - stored_count);
+}
+
+int main(int argc, char * argv[]) {
+	if (argc < 2) {
+		printf("usage: asset_cooker <assets directory> [<pack file>]\n");
+		return 1;
+	}
+
+	// @Note: workers let large meshes be parsed in parallel chunks
+	custom::thread::init(custom::empty_index);
+
+	// @Note: `assets` of `bin/Shipping/sandbox/assets` is the prefix of packed paths
+	cstring root = argv[1];
+	u32 root_length = (u32)strlen(root);
+	while (root_length > 0 && (root[root_length - 1] == '/' || root[root_length - 1] == '\\')) { --root_length; }
+	u32 name_offset = root_length;
+	while (name_offset > 0 && root[name_offset - 1] != '/' && root[name_offset - 1] != '\\') { --name_offset; }
+	pack_prefix.push_range(root + name_offset, root_length - name_offset);
+
+	custom::Array<char> root_path;
+	root_path.push_range(root, root_length);
+	root_path.push('\0');
+	cook_directory(root_path.data);
+
+	if (argc > 2) { write_pack(argv[2], root_length); }
+
+	custom::thread::shutdown();
+
+	printf("---- COOK ASSETS: %u cooked, %u failed ----\n", cooked_count, failed_count);
+	return failed_count ? 1 : 0;
+}
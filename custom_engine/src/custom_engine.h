@@ -13,6 +13,7 @@
 #include "engine/api/platform/window.h"
 #include "engine/api/platform/file.h"
 #include "engine/api/platform/graphics_vm.h"
+#include "engine/api/platform/thread.h"
 #include "engine/api/internal/strings_storage.h"
 #include "engine/api/internal/bytecode.h"
 #include "engine/api/internal/loader.h"
@@ -23,5 +24,6 @@
 #include "engine/api/internal/lua.h"
 #include "engine/api/internal/asset_types.h"
 #include "engine/api/internal/component_types.h"
+#include "engine/api/internal/system_scheduler.h"
 #include "engine/api/rendering_settings.h"
 #include "engine/api/graphics_params.h"
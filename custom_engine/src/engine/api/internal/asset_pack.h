@@ -0,0 +1,42 @@
+#pragma once
+#include "engine/core/collection_types.h"
+#include "engine/api/platform/file.h"
+
+namespace custom {
+namespace pack {
+
+// @Note: a pack is a single file of assets, mapped into memory at once; file layout:
+//        `Header`, `Entry` array sorted by path hashes, zero-terminated paths, data;
+//        stored entries are aligned and followed by a zero byte, so that loaders get
+//        them in place; `packed_count` is less than `count` for LZ4 compressed entries
+
+constexpr u32 const magic     = 0x4b434150; // "PACK"
+constexpr u32 const version   = 1;
+constexpr u32 const alignment = 16;
+
+struct Header {
+	u32 magic;
+	u32 version;
+	u32 entries_count;
+	u32 paths_count;
+};
+
+struct Entry {
+	u32 hash;
+	u32 path;         // an offset into the paths block
+	u64 offset;       // an offset from the start of the file
+	u64 count;
+	u64 packed_count;
+};
+
+u32 hash_path(cstring path);
+
+bool mount(cstring path);
+void unmount(void);
+bool is_mounted(void);
+
+// @Note: stored entries come as views into the mapping, valid until `unmount`, while
+//        compressed ones are unpacked into `buffer`; returns false if there's no such path
+bool read(cstring path, file::View & view, Array<u8> & buffer);
+
+}}
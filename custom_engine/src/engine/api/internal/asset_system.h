@@ -16,6 +16,14 @@ namespace custom {
 #define LOADING_FUNC(ROUTINE_NAME) void ROUTINE_NAME(Asset & asset_ref)
 typedef LOADING_FUNC(loading_func);
 
+// @Note: decoding runs on a background thread and mustn't touch shared state;
+//        applying runs on the main thread and takes ownership of the result
+#define DECODING_FUNC(ROUTINE_NAME) void * ROUTINE_NAME(cstring path)
+typedef DECODING_FUNC(decoding_func);
+
+#define APPLYING_FUNC(ROUTINE_NAME) void ROUTINE_NAME(Asset & asset_ref, void * decoded)
+typedef APPLYING_FUNC(applying_func);
+
 }
 
 //
@@ -30,7 +38,14 @@ template<typename T> struct Asset_RefT
 
 	cstring get_path(void) const;
 	bool exists(void) const;
+	bool is_pending(void) const;
+	bool is_failed(void) const;
 	void destroy(void);
+
+	// usage API
+	void acquire(void) const;
+	void release(void) const;
+	void assign(Asset_RefT const & value);
 };
 
 template<typename T> struct Asset_Registry { static u32 type; };
@@ -42,10 +57,23 @@ struct Asset : public Ref
 	u32 resource;
 	u32 type;
 
+	enum struct Status : u8 {
+		Loaded,
+		Pending, // waits for an asynchronous load to complete
+		Failed,  // an asynchronous load has failed; the asset is empty
+	};
+
 	struct State {
-		Array<Ref> instance_refs;
-		Array<u32> resources;
-		Array<u32> types;
+		Array<Ref>    instance_refs;
+		Array<u32>    resources;
+		Array<u32>    types;
+		Array<Status> statuses;
+		Array<u32>    ref_counts;
+		Array<u32>    idle_since; // a frame of the release to zero; `empty_index` unless awaits collection
+		// @Note: open addressing tables of slot indices, `empty_index` is a free entry;
+		//        keyed by `(type, resource)` and by `resource` alone, respectively
+		Array<u32>    key_index;
+		Array<u32>    resource_index;
 	};
 	struct VTable {
 		Array<ref_void_func *> create;
@@ -54,10 +82,21 @@ struct Asset : public Ref
 		Array<loading_func *>  load;
 		Array<loading_func *>  unload;
 		Array<loading_func *>  update;
+		Array<decoding_func *> decode; // `NULL` if the type can't be loaded asynchronously
+		Array<applying_func *> apply;
+	};
+	// @Note: a thread filling a staging world doesn't touch the shared state;
+	//        it interns paths into its own storage and only records assets
+	//        to add, leaving refs empty; see `Entity::merge_world`
+	struct Staging {
+		Strings_Storage strings; // starts as a copy of `Asset::strings`
+		Array<u32> types;
+		Array<u32> resources;
 	};
 	static State state;
 	static VTable vtable;
 	static Strings_Storage strings;
+	static thread_local Staging * staging;
 
 	// strings API
 	static u32 store_string(cstring data, u32 length);
@@ -68,17 +107,42 @@ struct Asset : public Ref
 	static void update(void);
 	static void reset_system(u32 type);
 
+	// @Note: `add_async` returns a pending asset; its file is read and decoded by background
+	//        threads, while `apply_async` completes finished loads at a frame boundary, so
+	//        that graphics instructions go along with the next frame; `wait_async` blocks
+	//        until nothing is pending anymore
+	static void apply_async(void);
+	static void wait_async(void);
+
+	// @Note: an asset, which references count drops to zero, stays idle for the grace
+	//        period, counted in `collect_unused` calls, and gets removed afterwards;
+	//        assets, which have never been acquired, live until being removed explicitly
+	static void set_grace_period(u32 frames);
+	static void collect_unused(void);
+
 	// types API
 	static Asset add(u32 type, u32 resource);
+	static Asset add_async(u32 type, u32 resource);
 	static void  rem(u32 type, u32 resource);
 	static Asset get(u32 type, u32 resource);
 	static bool  has(u32 type, u32 resource);
 
 	cstring get_path(void) const;
 	bool exists(void) const;
+	bool is_pending(void) const;
+	bool is_failed(void) const;
 	void destroy(void);
 
+	// usage API
+	// @Note: once acquired, an asset lives only while its count is positive; thus
+	//        any long-lived holder, be it a component, a global or a Lua userdata,
+	//        should acquire it, or else might end up with a collected asset
+	void acquire(void) const;
+	void release(void) const;
+	u32  get_ref_count(void) const;
+
 	template<typename T> static Asset_RefT<T> add(u32 resource);
+	template<typename T> static Asset_RefT<T> add_async(u32 resource);
 	template<typename T> static void          rem(u32 resource);
 	template<typename T> static Asset_RefT<T> get(u32 resource);
 	template<typename T> static bool          has(u32 resource);
@@ -3,14 +3,24 @@
 #include "engine/core/math_types.h"
 #include "engine/core/collection_types.h"
 #include "engine/api/internal/entity_system.h"
+#include "engine/api/internal/bytecode.h"
+#include "engine/api/platform/file.h"
 #include "engine/api/graphics_params.h"
 
 namespace custom {
 
+// @Note: a cooked file is a load-ready binary form of a source one; it starts with
+//        this header, which a zero byte in front of tells apart from text formats;
+//        `update` accepts both, while `cook` writes one for the asset cooker
+struct Cooked_Header {
+	u32 magic;
+	u32 version;
+};
+
 struct Shader_Asset {
 	Array<u8> source;
 
-	void update(Array<u8> & file);
+	void update(file::View file);
 
 	~Shader_Asset() = default;
 };
@@ -27,11 +37,17 @@ struct Texture_Asset {
 	graphics::Filter_Mode min_tex, min_mip, mag_tex;
 	graphics::Wrap_Mode wrap_x, wrap_y;
 
-	void update(Array<u8> & file);
+	void update(file::View file);
+	void cook(Bytecode & bc) const;
 
 	~Texture_Asset() = default;
 };
 
+// @Note: meshes are reordered for the vertex cache and get `u16` indices if possible;
+//        quantization stores attributes past positions as normalized `s16`, given
+//        they lie within [-1, 1]
+// #define MESH_QUANTIZE_ATTRIBUTES
+
 struct Mesh_Asset {
 	struct Buffer {
 		Array<u8> attributes;
@@ -45,7 +61,8 @@ struct Mesh_Asset {
 	};
 	Array<Buffer> buffers;
 
-	void update(Array<u8> & file);
+	void update(file::View file);
+	void cook(Bytecode & bc) const;
 
 	~Mesh_Asset(); // @Note: array is POD and doesn't call elements' destructor
 };
@@ -53,7 +70,8 @@ struct Mesh_Asset {
 struct Collider2d_Asset {
 	Array<vec2> points;
 
-	void update(Array<u8> & file);
+	void update(file::View file);
+	void cook(Bytecode & bc) const;
 
 	~Collider2d_Asset() = default;
 };
@@ -83,7 +101,7 @@ struct Config_Asset {
 	template<typename T> void set_value(cstring key, T value);
 	template<typename T> T get_value(cstring key, T default_value) const;
 
-	void update(Array<u8> & file);
+	void update(file::View file);
 
 	~Config_Asset() = default;
 };
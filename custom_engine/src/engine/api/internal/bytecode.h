@@ -19,10 +19,13 @@ struct Bytecode
 	void write_bytes(u8 alignment, u8 const * data, u32 count);
 	u8 const * read_bytes(u8 alignment, u32 count) const;
 	void copy_bytes(u8 alignment, u8 * out, u32 count) const;
+	bool can_read_bytes(u8 alignment, u64 count) const;
 
 	template<typename T> void      write(T const * data, u32 count);
 	template<typename T> T const * read(u32 count = 1) const;
 	template<typename T> void      copy(T * out, u32 count = 1) const;
+	// @Note: tells whether `count` elements of `T` lie ahead, e.g. before reading untrusted counts
+	template<typename T> bool      can_read(u32 count = 1) const;
 
 	template<typename T> inline void write(T const & datum) { write(&datum, 1); }
 	
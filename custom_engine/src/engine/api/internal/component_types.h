@@ -16,6 +16,9 @@ struct Transform
 	mat4 to_matrix(void) const;
 	vec3 transform(vec3 const & value) const;
 	Transform transform(Transform const & value) const;
+	// @Note: reverts `transform`, so a world space value becomes local to this one
+	vec3 inverse_transform(vec3 const & value) const;
+	Transform inverse_transform(Transform const & value) const;
 };
 
 struct Camera
@@ -34,13 +37,48 @@ struct Camera
 struct Hierarchy {
 	custom::Entity parent = {custom::empty_ref};
 
-	struct Link { u32 id; custom::Entity entity; };
-	static custom::Array<Link> links;
+	// @Note: intrusive links, so that traversal is proportional to a subtree size;
+	//        entity ids or `custom::empty_index`
+	struct Link { u32 parent, first_child, last_child, prev_sibling, next_sibling; };
+	static custom::Array<Link> & get_links(void); // sparse; entity id to its links; per world
 
-	static void fetch_children(custom::Entity const & entity, custom::Array<Hierarchy::Link> & buffer);
+	static void ensure_capacity(u32 entities_count);
+	static void fetch_children(custom::Entity const & entity, custom::Array<custom::Entity> & buffer);
 	static void set_parent(custom::Entity & child, custom::Entity const & entity);
 	static void rem_parent(custom::Entity & child, custom::Entity const & entity);
-	static void remove_at(u32 id);
+	static void remove(custom::Entity const & entity);
+	static void reset(void);
+};
+
+// @Note: world space transforms of every entity having a `Transform`, stored
+//        parent-before-child; `update` recomputes only subtrees of the `Transform`
+//        components written since the previous call; see `custom::change_tick`
+struct Transform_Cache {
+	// @Note: per world; see `custom::Entity::State::hooks`
+	struct Storage {
+		custom::Array<custom::Entity> entities; // parent-before-child order
+		custom::Array<custom::Ref>    locals;
+		custom::Array<u32>            parents;  // order index or `custom::empty_index`
+		custom::Array<u32>            versions; // `custom::change_tick` of the last recomputation
+		custom::Array<Transform>      transforms;
+		custom::Array<mat4>           matrices;
+		custom::Array<u32>            slots;    // sparse; entity id to order index
+		b8  is_dirty;
+		u32 tick;
+	};
+	static Storage & get_storage(void);
+
+	static void add(custom::Entity const & entity);
+	static void remove(custom::Entity const & entity);
+	static void mark_dirty(void);
+	static void update(void);
+
+	static Transform const * get_transform(custom::Entity const & entity);
+	static mat4 const * get_matrix(custom::Entity const & entity);
+	// @Note: writes a world space value into the local `Transform` via the cached parent;
+	//        the cache itself catches up with the next `update`
+	static void set_transform(custom::Entity const & entity, Transform const & value);
+	static u32 get_version(custom::Entity const & entity);
 };
 
 // struct Transform2d
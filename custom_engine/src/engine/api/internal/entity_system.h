@@ -4,15 +4,23 @@
 
 // https://github.com/etodd/lasercrabs/blob/master/src/data/entity.h
 
-// @Note: two modes:
-//        - dense: SoA of {component ref, type, entity id}
+// @Note: three modes:
+//        - dense: a sparse set per component type; entity id to a packed
+//          array of {component ref, entity id}
+//        - archetype: entities with the same set of components share a table;
+//          component refs are packed into chunks of per-type columns; a layout
+//          experiment so far: components themselves stay in their `RefT<T>` pools,
+//          so walking a column still jumps through a ref per entity
 //        - sparse: each enity always has N components, some of them active;
 //          packed into blocks inside `components` array
 // #define ENTITY_COMPONENTS_DENSE
+// #define ENTITY_COMPONENTS_ARCHETYPE
 
 namespace custom {
 	// @Forward
 	struct Entity;
+	struct Bytecode;
+	struct Snapshot_Remap;
 }
 
 //
@@ -30,6 +38,18 @@ typedef ENTITY_LOADING_FUNC(entity_loading_func);
 #define READ_FUNC(ROUTINE_NAME) void ROUTINE_NAME(Entity & entity, Ref & ref, cstring * source)
 typedef READ_FUNC(read_func);
 
+#define SNAPSHOT_WRITE_FUNC(ROUTINE_NAME) void ROUTINE_NAME(Bytecode & bc)
+typedef SNAPSHOT_WRITE_FUNC(snapshot_write_func);
+
+#define SNAPSHOT_READ_FUNC(ROUTINE_NAME) bool ROUTINE_NAME(Bytecode const & bc)
+typedef SNAPSHOT_READ_FUNC(snapshot_read_func);
+
+#define SNAPSHOT_REMAP_FUNC(ROUTINE_NAME) void ROUTINE_NAME(Ref & ref, Snapshot_Remap const & remap)
+typedef SNAPSHOT_REMAP_FUNC(snapshot_remap_func);
+
+#define POOL_MERGE_FUNC(ROUTINE_NAME) void ROUTINE_NAME(void * source, Array<Relocation> & relocations)
+typedef POOL_MERGE_FUNC(pool_merge_func);
+
 }
 
 //
@@ -41,42 +61,132 @@ namespace custom {
 template<typename T> struct Component_Registry { static u32 type; };
 template<typename T> u32 Component_Registry<T>::type;
 
-// @Todo: separate Entity_System container from Entity? and make the system container an instance?
 struct Entity : public Ref
 {
+	#if defined(ENTITY_COMPONENTS_ARCHETYPE)
+	// @Note: entities of an archetype share the same signature;
+	//        columns hold refs, not the component data
+	struct Archetype {
+		constexpr static u32 const chunk_rows = 64;
+
+		u64 signature;
+		u32 columns;
+		Array<u32> entity_ids; // dense; row to entity id
+		Array<Ref> components; // chunks of `columns` runs of `chunk_rows` refs each
+
+		inline u32 get_chunks_count(void) const { return (entity_ids.count + chunk_rows - 1) / chunk_rows; }
+		inline Ref * get_column(u32 chunk, u32 column) { return components.data + (chunk * columns + column) * chunk_rows; }
+		inline Ref & get(u32 row, u32 column) { return get_column(row / chunk_rows, column)[row % chunk_rows]; }
+		u32 get_column_index(u32 type) const;
+	};
+	#endif
+
+	#if defined(ENTITY_COMPONENTS_DENSE)
+	// @Note: entities owning a component of the same type; removal swaps the last in
+	struct Component_Set {
+		Array<u32> slots;      // sparse; entity id to dense index
+		Array<u32> entity_ids; // dense
+		Array<Ref> components; // dense
+	};
+	#endif
+
+	// @Note: a deferred structural change; see `apply_commands`
+	struct Command {
+		enum struct Action : u8 {Create, Copy, Add, Rem, Destroy};
+		Action action;
+		b8     is_instance;
+		u32    type;   // component type for `Add` and `Rem`
+		Ref    entity;
+		Ref    source; // prefab for `Copy`
+	};
+
 	struct State {
 		// entities
 		Gen_Pool        generations;
+		Array<u64>      signatures;     // sparse; a bit per component type
+		Array<u32>      instance_slots; // sparse; entity id to `instances` index
 		Array<Entity>   instances;
 
 		// components
+		#if defined(ENTITY_COMPONENTS_ARCHETYPE)
+		Array<Archetype> archetypes;
+		Array<u32> archetype_ids;  // sparse; entity id to archetype
+		Array<u32> archetype_rows; // sparse; entity id to row
+		#elif defined(ENTITY_COMPONENTS_DENSE)
+		Array<Component_Set> component_sets; // per component type
+		#else
 		Array<Ref> components;
-
-		#if defined(ENTITY_COMPONENTS_DENSE)
-		Array<u32> component_types;
-		Array<u32> component_entity_ids;
 		#endif
+
+		// deferred
+		Array<Command> commands;
+
+		// world
+		Array<void *> pools; // per component type, `Ref_PoolT<T> *`; empty for the default world
+		void * hooks;        // owned by the hooks; see `entity_do_destroy_world`
 	};
 	struct VTable {
 		Array<ref_void_func *> create;
 		Array<void_ref_func *> destroy;
 		Array<bool_ref_func *> contains;
+		Array<void_u32_func *> reserve;
+		Array<void_ref_func *> touch;
+		Array<void_void_func *> compact;
+		Array<ref_ref_func *> relocate;
 		Array<entity_from_to_func *> copy;
 		Array<entity_loading_func *> load;
 		Array<entity_loading_func *> unload;
 		Array<read_func *> read;
+		Array<snapshot_write_func *> snapshot_write;
+		Array<snapshot_read_func *> snapshot_read;
+		Array<snapshot_remap_func *> snapshot_remap;
+		Array<ptr_void_func *> pool_create;
+		Array<void_ptr_func *> pool_destroy;
+		Array<void_ptr_func *> pool_bind;
+		Array<pool_merge_func *> pool_merge;
+		u64 tags; // a bit per tag type; see `TAG_IMPL`
 	};
-	static State state;
+	static State state;                // the default world
+	static thread_local State * world; // the world bound to the calling thread
 	static VTable vtable;
 	static Strings_Storage strings;
+	static thread_local Strings_Storage * staging_strings; // replaces `strings` for the calling thread; see `merge_world`
 
 	// strings API
 	static u32 store_string(cstring data, u32 length);
 	static u32 get_id(cstring data, u32 length);
 	static cstring get_string(u32 id);
 
+	// world API
+	// @Note: a world is a separate set of entities and component pools; the rest
+	//        of the static API operates on the world bound to the calling thread,
+	//        which is the default one, unless `bind_world` tells otherwise;
+	//        a world is expected to be bound to a single thread at a time,
+	//        while `vtable` and `strings` are shared
+	static State * create_world(void);
+	static void destroy_world(State * world);
+	static State * bind_world(State * world); // `NULL` stands for the default one; returns the previous one
+	// @Note: moves entities of the `source` world into the bound one and destroys
+	//        `source`; component pools are appended in bulk, entity ids are remapped,
+	//        `out` receives an entity per `source` id, empty for the unused ones;
+	//        a `remap` translates string ids of a world filled with `staging_strings`
+	//        and `Asset::staging` in effect, resolving its assets on the way
+	static void merge_world(State * source, Snapshot_Remap const * remap, Array<Entity> & out);
+
 	// system API
 	static void reset_system(void);
+	// @Note: compacts component pools and rewrites stored component refs;
+	//        see `Ref_PoolT::compact`
+	static void compact(void);
+
+	// snapshot API
+	// @Note: a versioned binary dump of the whole world: generations, instances,
+	//        hierarchy and raw component pools; reading requires an empty world
+	//        and the same component types registered; it returns false for truncated
+	//        or corrupted data, which might leave the world partially read, so
+	//        read untrusted data into a world of its own; see `create_world`
+	static void write_snapshot(Bytecode & bc);
+	static bool read_snapshot(Bytecode const & bc);
 
 	// entity API
 	static Entity create(bool is_instance);
@@ -84,9 +194,11 @@ struct Entity : public Ref
 	void override_with(Entity const & source);
 	void destroy(void);
 	bool is_instance() const;
+	u64 get_signature(void) const;
 	Entity copy(bool force_instance) const;
+	void copy_many(u32 count, bool force_instance, Array<Entity> & out) const;
 	void promote_to_instance(void);
-	inline bool exists(void) const { return state.generations.contains(*this); }
+	inline bool exists(void) const { return world->generations.contains(*this); }
 
 	// components API
 	Ref  add_component(u32 type);
@@ -98,6 +210,44 @@ struct Entity : public Ref
 	template<typename T> void    rem_component(void);
 	template<typename T> RefT<T> get_component(void) const;
 	template<typename T> bool    has_component(void) const;
+
+	// @Note: tags are component types without data; they are stored only
+	//        as signature bits, thus `add_component` returns an empty ref
+	static bool is_tag(u32 type);
+
+	// deferred API
+	// @Note: entities are reserved immediately, but become instances
+	//        and receive components only upon `apply_commands`
+	static Entity create_deferred(bool is_instance);
+	Entity copy_deferred(bool force_instance) const;
+	void destroy_deferred(void);
+	void add_component_deferred(u32 type);
+	void rem_component_deferred(u32 type);
+	static void apply_commands(void);
+
+	// query API
+	// @Note: visits instances having all of the `Ts` components and all of the `tags`;
+	//        the callback receives `(Entity, Ts * ...)`; see `make_signature`
+	template<typename... Ts, typename Callback> static void query(Callback callback, u64 tags = 0);
+	// @Note: visits only a `chunk`-th part of the matching instances out of `chunks_count`,
+	//        so that an iteration can be split across threads
+	template<typename... Ts, typename Callback> static void query_chunk(u32 chunk, u32 chunks_count, Callback callback, u64 tags = 0);
+	template<typename... Ts> static u64 make_signature(void);
+	// @Note: visits instances any of the `Ts` components of which were written
+	//        at `tick` or later; see `change_tick`; writes are those stamped with
+	//        `touch`, so callbacks writing through `Ts *` should touch as well
+	template<typename... Ts, typename Callback> static void query_changed(u32 tick, Callback callback, u64 tags = 0);
+};
+
+// @Note: translates string ids, stored inside components of a snapshot,
+//        into the current `Entity::strings` and `Asset::strings` ones
+struct Snapshot_Remap
+{
+	Array<u32> entity_strings;
+	Array<u32> asset_strings;
+
+	inline u32 get_entity_string(u32 id) const { return (id < entity_strings.count) ? entity_strings[id] : custom::empty_index; }
+	inline u32 get_asset_string(u32 id) const { return (id < asset_strings.count) ? asset_strings[id] : custom::empty_index; }
 };
 
 // @Note: experimental, mimics Asset; in case one needs fully self-contained ref
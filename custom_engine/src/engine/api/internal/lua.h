@@ -10,5 +10,6 @@ void init_graphics_params(lua_State * L);
 void init_math_linear(lua_State * L);
 void init_asset_system(lua_State * L);
 void init_entity_system(lua_State * L);
+void init_scene_streaming(lua_State * L);
 
 }}
@@ -1,9 +1,15 @@
 #pragma once
 #include "engine/core/collection_types.h"
 
+// @Note: two modes of `Ref_PoolT` storage:
+//        - contiguous: a single array; growth reallocates and copies it
+//        - paged: fixed-size pages; growth allocates a page, addresses are stable
+// #define REF_POOL_PAGED
+
 namespace custom {
 	// @Forward
 	template<typename T> struct Ref_PoolT;
+	struct Bytecode;
 }
 
 //
@@ -29,20 +35,31 @@ inline bool operator!=(Ref const & a, Ref const & b) {
 template<typename T>
 struct RefT : public Ref
 {
-	// @Todo: factor this state out, too
+	// @Note: `pool` is the default storage; a thread might bind another one
+	//        instead, e.g. entity worlds do so for component types
 	static Ref_PoolT<T> pool;
+	static thread_local Ref_PoolT<T> * bound_pool;
+	inline static Ref_PoolT<T> & get_pool(void) { return bound_pool ? *bound_pool : pool; }
+
+	inline static RefT<T> create(void) { return get_pool().create(); }
+	inline void destroy(void) { return get_pool().destroy(*this); }
+	inline bool exists(void) const { return get_pool().contains(*this); }
 
-	inline static RefT<T> create(void) { return RefT<T>::pool.create(); }
-	inline void destroy(void) { return RefT<T>::pool.destroy(*this); }
-	inline bool exists(void) const { return RefT<T>::pool.contains(*this); }
+	// @Note: mutable access doesn't stamp the version, as most of it only reads;
+	//        writers must call `touch`, otherwise `query_changed` and
+	//        `Transform_Cache` won't see the change
+	inline T * get_fast(void) { return get_pool().get_fast(*this); }
+	inline T * get_safe(void) { return get_pool().get_safe(*this); }
 
-	inline T * get_fast(void) { return RefT<T>::pool.get_fast(*this); }
-	inline T * get_safe(void) { return RefT<T>::pool.get_safe(*this); }
+	inline T const * get_fast(void) const { return get_pool().get_fast(*this); }
+	inline T const * get_safe(void) const { return get_pool().get_safe(*this); }
 
-	inline T const * get_fast(void) const { return RefT<T>::pool.get_fast(*this); }
-	inline T const * get_safe(void) const { return RefT<T>::pool.get_safe(*this); }
+	inline void touch(void) { get_pool().touch(*this); }
+	inline void relocate(void) { Ref ref = get_pool().relocate(*this); id = ref.id; gen = ref.gen; }
+	inline u32 get_version(void) const { return get_pool().get_version(*this); }
 };
 template<typename T> Ref_PoolT<T> RefT<T>::pool;
+template<typename T> thread_local Ref_PoolT<T> * RefT<T>::bound_pool = NULL;
 
 }
 
@@ -60,37 +77,86 @@ struct Gen_Pool
 
 	Array<u32> gens; // sparse; count indicates the last active object
 	Array<u32> gaps;
-	// @Todo: provide a relocation table, so that the data can be compressed?
+	u32 fresh_gen = 0; // generation of never used slots; raised upon compaction
 
 	// API
 	Ref create(void);
 	void destroy(Ref const & ref);
+	void ensure_capacity(u32 number);
+	u32 append(u32 count); // issues `count` consecutive fresh ids; returns the first one
 	inline bool contains(Ref const & ref) const { return (ref.id < gens.count) && (gens[ref.id] == ref.gen); };
+	inline bool is_empty(void) const { return gens.count == gaps.count; }
+
+	// snapshot API
+	// @Note: `read` checks the data against the remaining bytes before taking it,
+	//        returning false and leaving the pool intact if they are short
+	void write(Bytecode & bc) const;
+	bool read(Bytecode const & bc);
 };
 
 // @Todo: might want to dynamically init pools should the code be used from a DLL?
 //        not quite relates to the pool itself, but definitely to RefT and
 //        types/places that make use of it
+// @Note: maps an id, issued before the last compaction, to its current ref;
+//        `gen` tells if a ref being translated is the one that was relocated
+struct Relocation { u32 gen; Ref ref; };
+
+// @Note: a frame counter for change tracking; writers stamp pools' instances
+//        with it, see `Ref_PoolT::touch`; zero is never used as a tick;
+//        stamping is explicit, mutable getters don't do that
+extern u32 change_tick;
+
 template<typename T>
 struct Ref_PoolT
 {
 	~Ref_PoolT(void) = default;
 
 	Gen_Pool generations;
+	#if defined(REF_POOL_PAGED)
+	Array_Paged<T> instances; // sparse; count indicates the last active object
+	Array_Paged<u32> versions; // sparse; `change_tick` of the last write access
+	#else
 	Array<T> instances; // sparse; count indicates the last active object
+	Array<u32> versions; // sparse; `change_tick` of the last write access
+	#endif
+	Array<Relocation> relocations; // sparse; filled by `compact`
 
 	// API
 	RefT<T> create(void);
 	void destroy(Ref const & ref);
+	void reserve(u32 number);
+
+	// compaction API
+	// @Note: packs live instances to the front, preserving their order, and frees
+	//        the rest; refs issued before that are translated with `relocate`,
+	//        but only until the next compaction
+	void compact(void);
+	Ref relocate(Ref const & ref) const;
+
+	// merge API
+	// @Note: moves live instances of `source` to the end of the storage in one go,
+	//        leaving `source` empty; `relocations` maps `source` ids to the new refs
+	void append(Ref_PoolT<T> & source, Array<Relocation> & relocations);
+
+	// snapshot API
+	// @Note: raw dump of the storage; `T` is expected to be POD;
+	//        a failed `read` leaves the pool empty
+	void write(Bytecode & bc) const;
+	bool read(Bytecode const & bc);
 
 	// RefT API
 	inline bool contains(Ref const & ref) const { return generations.contains(ref); };
 
+	// @Note: doesn't stamp the version; writers must `touch` the instance
 	inline T * get_fast(Ref const & ref) { return &instances[ref.id]; }
 	inline T * get_safe(Ref const & ref) { return generations.contains(ref) ? &instances[ref.id] : NULL; }
 
 	inline T const * get_fast(Ref const & ref) const { return &instances[ref.id]; }
 	inline T const * get_safe(Ref const & ref) const { return generations.contains(ref) ? &instances[ref.id] : NULL; }
+
+	// change tracking API
+	inline void touch(Ref const & ref) { versions[ref.id] = change_tick; }
+	inline u32 get_version(Ref const & ref) const { return versions[ref.id]; }
 };
 
 }
@@ -111,4 +177,19 @@ typedef VOID_REF_FUNC(void_ref_func);
 #define BOOL_REF_FUNC(ROUTINE_NAME) bool ROUTINE_NAME(Ref const & ref)
 typedef BOOL_REF_FUNC(bool_ref_func);
 
+#define VOID_U32_FUNC(ROUTINE_NAME) void ROUTINE_NAME(u32 value)
+typedef VOID_U32_FUNC(void_u32_func);
+
+#define VOID_VOID_FUNC(ROUTINE_NAME) void ROUTINE_NAME(void)
+typedef VOID_VOID_FUNC(void_void_func);
+
+#define REF_REF_FUNC(ROUTINE_NAME) Ref ROUTINE_NAME(Ref const & ref)
+typedef REF_REF_FUNC(ref_ref_func);
+
+#define PTR_VOID_FUNC(ROUTINE_NAME) void * ROUTINE_NAME(void)
+typedef PTR_VOID_FUNC(ptr_void_func);
+
+#define VOID_PTR_FUNC(ROUTINE_NAME) void ROUTINE_NAME(void * value)
+typedef VOID_PTR_FUNC(void_ptr_func);
+
 }
@@ -0,0 +1,26 @@
+#pragma once
+#include "entity_system.h"
+
+namespace custom {
+namespace streaming {
+
+// @Note: a scene file is read and instantiated on a background thread into
+//        a staging world, which `update` merges into the main one at a frame
+//        boundary; see `Entity::merge_world`. unloading destroys entities of
+//        a scene over several frames, `unload_budget` of them per frame at most
+Ref  load(cstring path);
+void unload(Ref const & scene);
+bool is_loaded(Ref const & scene);
+Entity get_root(Ref const & scene);
+
+void set_unload_budget(u32 entities_per_frame);
+void update(void);
+void shutdown(void);
+
+// staging API
+// @Note: for readers, which run on a staging thread; nested prefabs are read
+//        into the staging world, too, and are destroyed prior to the merge
+bool is_staging(void);
+Entity get_prefab(u32 path_id);
+
+}}
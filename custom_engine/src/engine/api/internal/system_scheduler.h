@@ -0,0 +1,30 @@
+#pragma once
+#include "engine/core/types.h"
+
+namespace custom {
+namespace scheduler {
+
+// @Note: a system processes `chunk`-th part of its work out of `chunks_count`;
+//        see `Entity::query_chunk`
+#define SYSTEM_FUNC(ROUTINE_NAME) void ROUTINE_NAME(r32 dt, u32 chunk, u32 chunks_count)
+typedef SYSTEM_FUNC(system_func);
+
+struct System {
+	system_func * callback;
+	u64 reads;  // component types signature; see `Entity::make_signature`
+	u64 writes; // component types signature; see `Entity::make_signature`
+	u32 chunks; // 1 unless the iteration might be split across threads
+	b8  main_thread; // e.g. Lua or graphics bytecode access
+};
+
+// @Note: systems run in the order of addition, unless they don't conflict
+//        by their read/write sets; a writer conflicts with anything touching
+//        its components, while readers might run simultaneously.
+//        main thread systems run alongside the workers busy with the rest of their stage,
+//        thus structural changes must be deferred from any system sharing a stage with
+//        others; see `Entity::apply_commands`
+void add_system(System const & system);
+void reset(void);
+void update(r32 dt);
+
+}}
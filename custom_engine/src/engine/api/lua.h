@@ -67,6 +67,14 @@ if (luaL_newmetatable(L, #T)) {    \
 }                                  \
 else { lua_pop(L, 1); }            \
 
+// @Note: tags have no instances, thus an empty metatable; it still
+//        becomes a global value, in order to hold the `type` field
+#define LUA_TAG_IMPL(T)         \
+if (luaL_newmetatable(L, #T)) { \
+    lua_setglobal(L, #T);       \
+}                               \
+else { lua_pop(L, 1); }         \
+
 // @Note: seek for a value in the corresponding metatable first,
 //        then pass execution further to the rest of the index method
 #define LUA_INDEX_RAWGET_IMPL(T) do {                                   \
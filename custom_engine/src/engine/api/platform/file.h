@@ -12,9 +12,23 @@ struct Action { u32 id; Action_Type type; };
 extern Strings_Storage strings;
 extern Array<Action> actions;
 
+// @Note: read-only file contents; loaders expect a zero byte past the end,
+//        so that text parsers can run without bounds checks
+struct View {
+	u8 const * data;
+	u64        count;
+};
+
 u64 get_time(cstring path);
 bool read(cstring path, Array<u8> & buffer);
 
+// @Note: maps a whole file into memory for reading; views of its parts are zero-copy;
+//        the rest of the last page reads as zeroes, so a view is followed by a zero
+//        byte, unless its size is a multiple of the page size
+bool map(cstring path, View & view);
+void unmap(View & view);
+u32  get_page_size(void);
+
 void watch_init(cstring path, bool subtree);
 void watch_update(void);
 void watch_shutdown(void);
@@ -0,0 +1,35 @@
+#pragma once
+#include "engine/core/types.h"
+
+namespace custom {
+namespace thread {
+
+#define THREAD_TASK_FUNC(ROUTINE_NAME) void ROUTINE_NAME(void * data, u32 index)
+typedef THREAD_TASK_FUNC(task_func);
+
+// @Note: `workers_count == empty_index` picks the number of logical cores minus the main thread
+void init(u32 workers_count);
+void shutdown(void);
+u32  get_workers_count(void);
+
+// @Note: calls `task(data, i)` for every `i` in `[0, count)`, spreading the calls
+//        over the workers and the calling thread; returns once all of them are done
+void run(task_func * task, void * data, u32 count);
+
+// @Note: same as `run`, but returns right after waking the workers, so that the calling
+//        thread might do unrelated work meanwhile; `wait` helps with the rest of the calls
+//        and returns once all of them are done. a single job might be in flight at once
+void run_async(task_func * task, void * data, u32 count);
+void wait(void);
+
+// @Note: calls `task(data, 0)` on a dedicated thread, apart from the workers, and
+//        returns immediately; `join` waits for the call to return and releases the handle
+struct Background_Task;
+Background_Task * start(task_func * task, void * data);
+// @Note: calls `task(data, i)` for every `i` in `[0, count)` on the workers, whenever they
+//        aren't busy with `run`; suits many short calls rather than a long-running one
+Background_Task * start_on_workers(task_func * task, void * data, u32 count);
+bool is_done(Background_Task * background_task);
+void join(Background_Task * background_task);
+
+}}
@@ -8,7 +8,7 @@
 #endif
 
 // @Note: this code implies POD types
-//        all of the T, Array<T>, Array_Fixed<T, N>
+//        all of the T, Array<T>, Array_Fixed<T, N>, Array_Paged<T>
 
 namespace custom {
 
@@ -84,4 +84,36 @@ struct Array_Fixed
 	void remove_at_ordered(u16 i);
 };
 
+// @Note: elements live in fixed-size pages, so that their addresses are stable;
+//        growth allocates a page and only the pages table gets reallocated
+template<typename T>
+struct Array_Paged
+{
+	constexpr static u32 const page_size = 256;
+
+	Array<T *> pages;
+	u32 capacity, count;
+
+	Array_Paged(void);
+	#if defined(COLLECTION_COPY_WARNING)
+		Array_Paged(Array_Paged const & source);
+	#endif
+	~Array_Paged(void);
+
+	#if defined(COLLECTION_COPY_WARNING)
+		Array_Paged & operator=(Array_Paged const & source);
+	#endif
+	T const & operator[](u32 i) const;
+	T & operator[](u32 i);
+	T const & get(u32 i) const;
+	T & get(u32 i);
+
+	void set_capacity(u32 number);
+	void ensure_capacity(u32 number);
+
+	void push(void);
+	void push(T const & value);
+	void pop(void);
+};
+
 }
@@ -0,0 +1,13 @@
+#pragma once
+#include "engine/core/types.h"
+
+namespace custom {
+namespace lz4 {
+
+// @Note: LZ4 block format, without frames or checksums;
+//        `compress` expects `get_bound(count)` bytes of output space
+u32 get_bound(u32 count);
+u32 compress(u8 const * source, u32 count, u8 * destination);
+bool decompress(u8 const * source, u32 count, u8 * destination, u32 destination_count);
+
+}}
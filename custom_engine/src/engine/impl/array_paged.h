@@ -0,0 +1,111 @@
+#pragma once
+#include "engine/core/code.h"
+#include "engine/core/collection_types.h"
+#include "engine/debug/log.h"
+#include "engine/impl/array.h"
+
+namespace custom {
+
+template<typename T>
+Array_Paged<T>::Array_Paged(void)
+	: pages()
+	, capacity(0)
+	, count(0)
+{ }
+
+#if defined(COLLECTION_COPY_WARNING)
+	template<typename T>
+	Array_Paged<T>::Array_Paged(Array_Paged const & source) {
+		CUSTOM_ASSERT(false, "ERROR! trying to copy a paged array");
+	}
+#endif
+
+template<typename T>
+Array_Paged<T>::~Array_Paged(void) {
+	set_capacity(0);
+}
+
+#if defined(COLLECTION_COPY_WARNING)
+	template<typename T>
+	Array_Paged<T> & Array_Paged<T>::operator=(Array_Paged const & source) {
+		CUSTOM_ASSERT(false, "ERROR! trying to copy a paged array");
+		return *this;
+	}
+#endif
+
+template<typename T>
+inline T const & Array_Paged<T>::operator[](u32 i) const {
+	CUSTOM_ASSERT(i < count, "index exceeds capacity");
+	return pages.data[i / page_size][i % page_size];
+}
+
+template<typename T>
+inline T & Array_Paged<T>::operator[](u32 i) {
+	CUSTOM_ASSERT(i < count, "index exceeds capacity");
+	return pages.data[i / page_size][i % page_size];
+}
+
+template<typename T>
+inline T const & Array_Paged<T>::get(u32 i) const {
+	CUSTOM_ASSERT(i < capacity, "index exceeds capacity");
+	return pages.data[i / page_size][i % page_size];
+}
+
+template<typename T>
+inline T & Array_Paged<T>::get(u32 i) {
+	CUSTOM_ASSERT(i < capacity, "index exceeds capacity");
+	return pages.data[i / page_size][i % page_size];
+}
+
+template<typename T>
+void Array_Paged<T>::set_capacity(u32 number) {
+	u32 pages_count = (number + page_size - 1) / page_size;
+
+	// @Note: pages are never moved, only allocated or freed
+	while (pages.count > pages_count) {
+		free(pages[pages.count - 1]);
+		pages.pop();
+	}
+
+	if (pages.count < pages_count) {
+		pages.ensure_capacity(pages_count);
+		while (pages.count < pages_count) {
+			T * page = (T *)malloc(page_size * sizeof(T));
+			CUSTOM_ASSERT(page, "failed to allocate memory of %zd bytes", page_size * sizeof(T));
+			pages.push(page);
+		}
+	}
+
+	if (!pages_count) { pages.set_capacity(0); }
+
+	capacity = pages.count * page_size;
+	if (count > capacity) {
+		count = capacity;
+	}
+}
+
+template<typename T>
+void Array_Paged<T>::ensure_capacity(u32 number) {
+	if (number > capacity) {
+		set_capacity(number);
+	}
+}
+
+template<typename T>
+void Array_Paged<T>::push(void) {
+	ensure_capacity(++count);
+}
+
+template<typename T>
+void Array_Paged<T>::push(T const & value) {
+	ensure_capacity(count + 1);
+	get(count++) = value;
+}
+
+template<typename T>
+void Array_Paged<T>::pop(void) {
+	CUSTOM_ASSERT(count > 0, "count is zero");
+	--count;
+}
+
+}
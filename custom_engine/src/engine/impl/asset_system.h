@@ -17,11 +17,39 @@ bool Asset_RefT<T>::exists(void) const {
 	return Asset{ref, resource, Asset_Registry<T>::type}.exists();
 }
 
+template<typename T>
+bool Asset_RefT<T>::is_pending(void) const {
+	return Asset{ref, resource, Asset_Registry<T>::type}.is_pending();
+}
+
+template<typename T>
+bool Asset_RefT<T>::is_failed(void) const {
+	return Asset{ref, resource, Asset_Registry<T>::type}.is_failed();
+}
+
 template<typename T>
 void Asset_RefT<T>::destroy(void) {
 	return Asset{ref, resource, Asset_Registry<T>::type}.destroy();
 }
 
+template<typename T>
+void Asset_RefT<T>::acquire(void) const {
+	Asset{ref, resource, Asset_Registry<T>::type}.acquire();
+}
+
+template<typename T>
+void Asset_RefT<T>::release(void) const {
+	Asset{ref, resource, Asset_Registry<T>::type}.release();
+}
+
+// @Note: acquires first, in case it's the same asset
+template<typename T>
+void Asset_RefT<T>::assign(Asset_RefT<T> const & value) {
+	value.acquire();
+	release();
+	*this = value;
+}
+
 }
 
 //
@@ -35,6 +63,11 @@ Asset_RefT<T> Asset::add(u32 resource) {
 	return {add(Asset_Registry<T>::type, resource), resource};
 }
 
+template<typename T>
+Asset_RefT<T> Asset::add_async(u32 resource) {
+	return {add_async(Asset_Registry<T>::type, resource), resource};
+}
+
 template<typename T>
 void Asset::rem(u32 resource) {
 	rem(Asset_Registry<T>::type, resource);
@@ -21,4 +21,9 @@ void Bytecode::copy(T * out, u32 count) const {
 	copy_bytes(alignof(T), (u8 *)out, count * sizeof(T));
 }
 
+template<typename T>
+bool Bytecode::can_read(u32 count) const {
+	return can_read_bytes(alignof(T), (u64)count * sizeof(T));
+}
+
 }
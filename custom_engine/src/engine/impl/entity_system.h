@@ -1,5 +1,6 @@
 #pragma once
 #include "engine/api/internal/entity_system.h"
+#include "engine/impl/math_bitwise.h"
 
 //
 // entity
@@ -29,6 +30,97 @@ bool Entity::has_component(void) const {
 
 }
 
+//
+// query
+//
+
+namespace custom {
+
+#if defined(ENTITY_COMPONENTS_ARCHETYPE)
+inline u32 Entity::Archetype::get_column_index(u32 type) const {
+	return count_bits(signature & (BIT(u64, type) - 1));
+}
+#endif
+
+template<typename... Ts>
+u64 Entity::make_signature(void) {
+	return (0 | ... | BIT(u64, Component_Registry<Ts>::type));
+}
+
+template<typename... Ts, typename Callback>
+void Entity::query(Callback callback, u64 tags) {
+	query_chunk<Ts...>(0, 1, callback, tags);
+}
+
+template<typename... Ts, typename Callback>
+void Entity::query_changed(u32 tick, Callback callback, u64 tags) {
+	query_chunk<Ts...>(0, 1, [&](Entity entity, Ts * ... components) {
+		if (!(false || ... || (entity.get_component<Ts>().get_version() >= tick))) { return; }
+		callback(entity, components...);
+	}, tags);
+}
+
+// @Note: adding or removing components and entities from within the callback isn't safe
+template<typename... Ts, typename Callback>
+void Entity::query_chunk(u32 chunk, u32 chunks_count, Callback callback, u64 tags) {
+	u64 const signature = make_signature<Ts...>();
+
+	#if defined(ENTITY_COMPONENTS_ARCHETYPE)
+	for (u32 archetype_i = 0; archetype_i < Entity::world->archetypes.count; ++archetype_i) {
+		Archetype & archetype = Entity::world->archetypes[archetype_i];
+		if (!bits_are_set(archetype.signature, signature)) { continue; }
+
+		u32 row_first = (u32)((u64)archetype.entity_ids.count * chunk / chunks_count);
+		u32 row_last  = (u32)((u64)archetype.entity_ids.count * (chunk + 1) / chunks_count);
+		for (u32 row = row_first; row < row_last; ++row) {
+			u32 entity_id = archetype.entity_ids[row];
+			Entity entity = {entity_id, Entity::world->generations.gens[entity_id]};
+			if (!entity.is_instance()) { continue; }
+			// @Note: tags don't split archetypes
+			if (!bits_are_set(Entity::world->signatures.get(entity_id), tags)) { continue; }
+			callback(entity, RefT<Ts>::get_pool().get_fast(
+				archetype.get(row, archetype.get_column_index(Component_Registry<Ts>::type))
+			)...);
+		}
+	}
+	#elif defined(ENTITY_COMPONENTS_DENSE)
+	static_assert(sizeof...(Ts) > 0, "query at least one component type");
+
+	// @Note: walk the smallest set of the queried types; entities outside of it can't match
+	u32 const types[] = {Component_Registry<Ts>::type...};
+	Component_Set const * smallest = NULL;
+	for (u32 i = 0; i < sizeof...(Ts); ++i) {
+		if (types[i] >= Entity::world->component_sets.count) { return; }
+		Component_Set const & set = Entity::world->component_sets[types[i]];
+		if (!smallest || set.entity_ids.count < smallest->entity_ids.count) { smallest = &set; }
+	}
+
+	u32 row_first = (u32)((u64)smallest->entity_ids.count * chunk / chunks_count);
+	u32 row_last  = (u32)((u64)smallest->entity_ids.count * (chunk + 1) / chunks_count);
+	for (u32 row = row_first; row < row_last; ++row) {
+		u32 entity_id = smallest->entity_ids[row];
+		Entity entity = {entity_id, Entity::world->generations.gens[entity_id]};
+		if (!entity.is_instance()) { continue; }
+		if (!bits_are_set(Entity::world->signatures.get(entity_id), signature | tags)) { continue; }
+		callback(entity, RefT<Ts>::get_pool().get_fast(
+			entity.get_component(Component_Registry<Ts>::type)
+		)...);
+	}
+	#else
+	u32 instance_first = (u32)((u64)Entity::world->instances.count * chunk / chunks_count);
+	u32 instance_last  = (u32)((u64)Entity::world->instances.count * (chunk + 1) / chunks_count);
+	for (u32 i = instance_first; i < instance_last; ++i) {
+		Entity entity = Entity::world->instances[i];
+		if (!bits_are_set(Entity::world->signatures.get(entity.id), signature | tags)) { continue; }
+		callback(entity, RefT<Ts>::get_pool().get_fast(
+			entity.get_component(Component_Registry<Ts>::type)
+		)...);
+	}
+	#endif
+}
+
+}
+
 //
 // component ref
 //
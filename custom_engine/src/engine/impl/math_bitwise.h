@@ -76,3 +76,19 @@ GET_BIT_AT_INDEX_IMPL(u64)
 GET_BIT_AT_INDEX_IMPL(s48)
 GET_BIT_AT_INDEX_IMPL(u48)
 #undef GET_BIT_AT_INDEX_IMPL
+
+//
+//
+//
+
+// https://en.wikipedia.org/wiki/Hamming_weight
+constexpr inline u32 count_bits(u64 container) {
+	container = container - ((container >> 1) & 0x5555555555555555ULL);
+	container = (container & 0x3333333333333333ULL) + ((container >> 2) & 0x3333333333333333ULL);
+	container = (container + (container >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+	return (u32)((container * 0x0101010101010101ULL) >> 56);
+}
+
+constexpr inline u32 get_lowest_bit_index(u64 container) {
+	return count_bits((container & (~container + 1)) - 1);
+}
@@ -1,5 +1,10 @@
 #pragma once
 #include "engine/api/internal/reference.h"
+#include "engine/impl/bytecode.h"
+
+#if defined(REF_POOL_PAGED)
+	#include "engine/impl/array_paged.h"
+#endif
 
 // https://github.com/etodd/lasercrabs/blob/master/src/data/entity.h
 
@@ -11,15 +16,167 @@ namespace custom {
 
 template<typename T>
 RefT<T> Ref_PoolT<T>::create(void) {
-	if (generations.gaps.count == 0) { instances.push(); }
+	if (generations.gaps.count == 0) { instances.push(); versions.push(); }
 	Ref ref = generations.create();
+	versions[ref.id] = change_tick;
 	return {ref};
 }
 
 template<typename T>
 void Ref_PoolT<T>::destroy(Ref const & ref) {
 	generations.destroy(ref);
-	if (ref.id == instances.count - 1) { instances.pop(); }
+	if (ref.id == instances.count - 1) { instances.pop(); versions.pop(); }
+}
+
+template<typename T>
+void Ref_PoolT<T>::reserve(u32 number) {
+	generations.ensure_capacity(instances.count + number);
+	instances.ensure_capacity(instances.count + number);
+	versions.ensure_capacity(instances.count + number);
+}
+
+template<typename T>
+void Ref_PoolT<T>::compact(void) {
+	u32 const count = generations.gens.count;
+
+	Array<u8> is_gap(count, count);
+	memset(is_gap.data, 0, count * sizeof(*is_gap.data));
+	for (u32 i = 0; i < generations.gaps.count; ++i) {
+		is_gap[generations.gaps[i]] = 1;
+	}
+
+	// @Note: a reused slot gets a newer generation, so that stale refs
+	//        to either of its former owners stay invalid
+	relocations.count = 0;
+	relocations.ensure_capacity(count);
+	u32 live = 0;
+	for (u32 id = 0; id < count; ++id) {
+		if (is_gap[id]) { relocations.push({custom::empty_index, custom::empty_ref}); continue; }
+
+		u32 gen = generations.gens[id];
+		Ref ref = {live, (id == live) ? gen : generations.gens[live] + 1};
+		relocations.push({gen, ref});
+		if (id != live) {
+			instances.get(live) = instances.get(id);
+			versions.get(live)  = versions.get(id);
+			generations.gens[live] = ref.gen;
+		}
+		++live;
+	}
+
+	// @Note: trimmed slots, including popped ones, might be referenced still
+	for (u32 i = live; i < generations.gens.capacity; ++i) {
+		u32 gen = generations.gens.data[i] + ((i < count) ? 1 : 0);
+		if (generations.fresh_gen < gen) { generations.fresh_gen = gen; }
+	}
+
+	generations.gaps.set_capacity(0);
+	generations.gens.count = live;
+	generations.gens.set_capacity(live);
+	instances.count = live;
+	instances.set_capacity(live);
+	versions.count = live;
+	versions.set_capacity(live);
+}
+
+template<typename T>
+Ref Ref_PoolT<T>::relocate(Ref const & ref) const {
+	if (generations.contains(ref)) { return ref; }
+	if (ref.id >= relocations.count) { return ref; }
+
+	Relocation const & relocation = relocations[ref.id];
+	return (relocation.gen == ref.gen) ? relocation.ref : ref;
+}
+
+template<typename T>
+void Ref_PoolT<T>::append(Ref_PoolT<T> & source, Array<Relocation> & relocations) {
+	u32 const count = source.generations.gens.count;
+
+	Array<u8> is_gap(count, count);
+	memset(is_gap.data, 0, count * sizeof(*is_gap.data));
+	for (u32 i = 0; i < source.generations.gaps.count; ++i) {
+		is_gap[source.generations.gaps[i]] = 1;
+	}
+
+	u32 const live  = count - source.generations.gaps.count;
+	u32 const first = generations.append(live);
+	instances.ensure_capacity(first + live);
+	versions.ensure_capacity(first + live);
+
+	// @Note: appended data counts as written this tick
+	relocations.count = 0;
+	relocations.ensure_capacity(count);
+	u32 next = first;
+	for (u32 id = 0; id < count; ++id) {
+		if (is_gap[id]) { relocations.push({custom::empty_index, custom::empty_ref}); continue; }
+		relocations.push({source.generations.gens[id], {next, generations.gens[next]}});
+		instances.get(next) = source.instances.get(id);
+		versions.get(next)  = change_tick;
+		++next;
+	}
+	instances.count = first + live;
+	versions.count  = first + live;
+
+	source.generations.gens.count = 0;
+	source.generations.gaps.count = 0;
+	source.instances.count = 0;
+	source.versions.count  = 0;
+}
+
+template<typename T>
+void Ref_PoolT<T>::write(Bytecode & bc) const {
+	generations.write(bc);
+	bc.write((u32)sizeof(T));
+	bc.write(instances.count);
+	#if defined(REF_POOL_PAGED)
+	for (u32 i = 0; i < instances.pages.count; ++i) {
+		u32 offset = i * instances.page_size;
+		if (offset >= instances.count) { break; }
+		u32 count = instances.count - offset;
+		bc.write(instances.pages[i], (count < instances.page_size) ? count : instances.page_size);
+	}
+	#else
+	bc.write(instances.data, instances.count);
+	#endif
+}
+
+template<typename T>
+bool Ref_PoolT<T>::read(Bytecode const & bc) {
+	CUSTOM_ASSERT(generations.is_empty(), "pool isn't empty");
+	if (!generations.read(bc)) { return false; }
+	relocations.count = 0;
+
+	bool is_valid = bc.can_read<u32>(2);
+	u32 size  = is_valid ? bc.read<u32>()[0] : 0;
+	u32 count = is_valid ? bc.read<u32>()[0] : 0;
+	CUSTOM_ASSERT(!is_valid || size == sizeof(T), "snapshot type size mismatch");
+
+	// @Note: instances mirror generations one to one
+	is_valid = is_valid && (size == sizeof(T)) && (count == generations.gens.count) && bc.can_read<T>(count);
+	if (!is_valid) {
+		generations.gens.count = 0;
+		generations.gaps.count = 0;
+		instances.count = 0;
+		versions.count  = 0;
+		return false;
+	}
+
+	instances.count = 0; instances.ensure_capacity(count);
+	#if defined(REF_POOL_PAGED)
+	for (u32 offset = 0; offset < count; offset += instances.page_size) {
+		u32 page_count = count - offset;
+		bc.copy(instances.pages[offset / instances.page_size], (page_count < instances.page_size) ? page_count : instances.page_size);
+	}
+	#else
+	bc.copy(instances.data, count);
+	#endif
+	instances.count = count;
+
+	// @Note: restored data counts as written this tick
+	versions.count = 0; versions.ensure_capacity(count);
+	for (u32 i = 0; i < count; ++i) { versions.get(i) = change_tick; }
+	versions.count = count;
+	return true;
 }
 
 }
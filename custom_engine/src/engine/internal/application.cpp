@@ -2,15 +2,19 @@
 
 #include "engine/core/code.h"
 #include "engine/debug/log.h"
+#include "engine/api/internal/asset_pack.h"
 #include "engine/api/internal/asset_system.h"
 #include "engine/api/internal/asset_types.h"
 #include "engine/api/platform/system.h"
 #include "engine/api/platform/timer.h"
+#include "engine/api/platform/thread.h"
 #include "engine/api/platform/window.h"
 #include "engine/api/platform/file.h"
 #include "engine/api/platform/graphics_vm.h"
 #include "engine/api/internal/application.h"
 #include "engine/api/internal/bytecode.h"
+#include "engine/api/internal/entity_system.h"
+#include "engine/api/internal/scene_streaming.h"
 #include "engine/api/internal/loader.h"
 #include "engine/api/internal/renderer.h"
 #include "engine/api/rendering_settings.h"
@@ -113,6 +117,7 @@ static void process_close_safely(custom::window::Internal_Data * window) {
 }
 
 static custom::Asset_RefT<custom::Config_Asset> config_ref = {custom::empty_ref, custom::empty_index};
+static cstring const asset_pack_path = "assets.pack";
 
 static void consume_config_init(void) {
 	custom::Config_Asset const * config = config_ref.ref.get_safe();
@@ -135,6 +140,10 @@ static void consume_config_init(void) {
 	custom::pixel_format_hint.stencil_bits = config->get_value<u32>("pixel_format_stencil_bits", 24);
 	custom::pixel_format_hint.doublebuffer = config->get_value<bln>("pixel_format_doublebuffer", true);
 	custom::pixel_format_hint.swap         = config->get_value<u32>("pixel_format_swap",         1);
+
+	// workers
+	s32 worker_threads = config->get_value<s32>("worker_threads", -1);
+	custom::thread::init(worker_threads < 0 ? custom::empty_index : (u32)worker_threads);
 }
 
 static void consume_config(void) {
@@ -161,8 +170,11 @@ static void init(void) {
 	custom::loader::init(&app.bytecode_loader);
 	custom::renderer::init(&app.bytecode_renderer);
 
+	// @Note: loose files are used for whatever the pack lacks, or if there's no pack at all
+	if (custom::file::get_time(asset_pack_path)) { custom::pack::mount(asset_pack_path); }
+
 	u32 config_id = Asset::store_string("assets/configs/engine.cfg", custom::empty_index);
-	config_ref = Asset::add<Config_Asset>(config_id);
+	config_ref.assign(Asset::add<Config_Asset>(config_id));
 
 	consume_config_init();
 	consume_config();
@@ -213,6 +225,11 @@ void run(void) {
 		// process the frame
 		u64 time_logic = custom::timer::get_ticks();
 		CALL_SAFELY(app.callbacks.update, dt);
+		custom::Entity::apply_commands();
+		custom::streaming::update();
+		custom::Asset::apply_async();
+		custom::Asset::collect_unused();
+		++custom::change_tick;
 		time_logic = custom::timer::get_ticks() - time_logic;
 
 		//
@@ -239,6 +256,10 @@ void run(void) {
 	}
 
 	custom::file::watch_shutdown();
+	custom::streaming::shutdown();
+	custom::Asset::wait_async();
+	custom::pack::unmount();
+	custom::thread::shutdown();
 	custom::timer::shutdown();
 	custom::graphics::shutdown();
 	if (app.window) { custom::window::destroy(app.window); }
@@ -0,0 +1,137 @@
+#include "custom_pch.h"
+
+#include "engine/core/code.h"
+#include "engine/core/lz4.h"
+#include "engine/debug/log.h"
+#include "engine/api/platform/file.h"
+#include "engine/api/internal/asset_pack.h"
+#include "engine/impl/array.h"
+
+// https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
+
+namespace custom {
+namespace pack {
+
+struct Pack_Data {
+	file::View    file;
+	Entry const * entries;
+	u32           entries_count;
+	cstring       paths;
+	u32           paths_count;
+};
+
+static Pack_Data pack_data;
+
+static Entry const * find(cstring path) {
+	u32 hash = hash_path(path);
+
+	// @Note: lower bound of the hash; collisions are resolved by paths
+	u32 first = 0, last = pack_data.entries_count;
+	while (first < last) {
+		u32 middle = first + (last - first) / 2;
+		if (pack_data.entries[middle].hash < hash) { first = middle + 1; }
+		else { last = middle; }
+	}
+
+	for (u32 i = first; i < pack_data.entries_count; ++i) {
+		Entry const * entry = pack_data.entries + i;
+		if (entry->hash != hash) { break; }
+		if (strcmp(pack_data.paths + entry->path, path) == 0) { return entry; }
+	}
+	return NULL;
+}
+
+static bool validate(cstring path) {
+	file::View const & file = pack_data.file;
+	if (file.count < sizeof(Header)) { CUSTOM_ASSERT(false, "pack is too small: '%s'", path); return false; }
+
+	Header const * header = (Header const *)file.data;
+	if (header->magic != magic) { CUSTOM_ASSERT(false, "not a pack: '%s'", path); return false; }
+	if (header->version != version) {
+		CUSTOM_ASSERT(false, "pack version is %u instead of %u; repack assets: '%s'", header->version, version, path);
+		return false;
+	}
+
+	u64 paths_offset = sizeof(Header) + (u64)header->entries_count * sizeof(Entry);
+	if (paths_offset + header->paths_count > file.count) { CUSTOM_ASSERT(false, "pack is truncated: '%s'", path); return false; }
+	if (header->paths_count && file.data[paths_offset + header->paths_count - 1]) { CUSTOM_ASSERT(false, "pack is corrupted: '%s'", path); return false; }
+
+	Entry const * entries = (Entry const *)(file.data + sizeof(Header));
+	for (u32 i = 0; i < header->entries_count; ++i) {
+		Entry const & entry = entries[i];
+		bool is_stored = (entry.packed_count == entry.count);
+		u64 end = entry.offset + entry.packed_count + (is_stored ? 1 : 0);
+		if (entry.path >= header->paths_count || end > file.count) { CUSTOM_ASSERT(false, "pack is corrupted: '%s'", path); return false; }
+	}
+
+	pack_data.entries       = entries;
+	pack_data.entries_count = header->entries_count;
+	pack_data.paths         = (cstring)(file.data + paths_offset);
+	pack_data.paths_count   = header->paths_count;
+	return true;
+}
+
+}}
+
+//
+// API implementation
+//
+
+namespace custom {
+namespace pack {
+
+u32 hash_path(cstring path) {
+	u32 hash = 2166136261U;
+	for (; *path; ++path) {
+		hash ^= (u8)*path;
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
+bool mount(cstring path) {
+	if (pack_data.file.data) { CUSTOM_ASSERT(false, "pack is mounted already"); return false; }
+	if (!file::map(path, pack_data.file)) { return false; }
+	if (!validate(path)) { unmount(); return false; }
+	return true;
+}
+
+void unmount(void) {
+	file::unmap(pack_data.file);
+	pack_data = {};
+}
+
+bool is_mounted(void) {
+	return pack_data.file.data != NULL;
+}
+
+bool read(cstring path, file::View & view, Array<u8> & buffer) {
+	if (!pack_data.file.data) { return false; }
+
+	Entry const * entry = find(path);
+	if (!entry) { return false; }
+
+	u8 const * data = pack_data.file.data + entry->offset;
+	if (entry->packed_count == entry->count) {
+		view = {data, entry->count};
+		return true;
+	}
+
+	if (entry->count >= UINT32_MAX) { CUSTOM_ASSERT(false, "entry is too large: '%s'", path); return false; }
+	u32 count = (u32)entry->count;
+
+	// @Note: allocate an additional byte for '\0'
+	buffer.set_capacity(count + 1);
+	if (!lz4::decompress(data, (u32)entry->packed_count, buffer.data, count)) {
+		CUSTOM_ASSERT(false, "failed to decompress: '%s'", path);
+		buffer.count = 0;
+		return false;
+	}
+	buffer.count = count;
+	buffer.data[count] = '\0';
+
+	view = {buffer.data, count};
+	return true;
+}
+
+}}
@@ -5,17 +5,159 @@
 #include "engine/api/internal/names_lookup.h"
 #include "engine/api/internal/asset_system.h"
 #include "engine/api/platform/file.h"
+#include "engine/api/platform/thread.h"
 #include "engine/impl/array.h"
+#include "engine/impl/math_hashing.h"
 
 namespace custom {
 
 //  @Note: initialize compile-time structs:
 template struct Array<Asset>;
+template struct Array<Asset::Status>;
 
 //  @Note: initialize compile-time statics:
 Asset::State    Asset::state;
 Asset::VTable   Asset::vtable;
 Strings_Storage Asset::strings;
+thread_local Asset::Staging * Asset::staging = NULL;
+
+}
+
+//
+// hashed index
+//
+
+namespace custom {
+
+typedef u32 slot_hash_func(u32 slot);
+
+inline static u32 key_hash(u32 type, u32 resource) {
+	return hash_jenkins(hash_jenkins(type) ^ resource);
+}
+
+inline static u32 resource_hash(u32 resource) {
+	return hash_jenkins(resource);
+}
+
+static u32 slot_key_hash(u32 slot) {
+	return key_hash(Asset::state.types[slot], Asset::state.resources[slot]);
+}
+
+static u32 slot_resource_hash(u32 slot) {
+	return resource_hash(Asset::state.resources[slot]);
+}
+
+static void index_insert(Array<u32> & table, u32 hash, u32 slot) {
+	u32 mask = table.count - 1;
+	u32 position = hash & mask;
+	while (table[position] != custom::empty_index) {
+		position = (position + 1) & mask;
+	}
+	table[position] = slot;
+}
+
+static u32 index_locate(Array<u32> & table, u32 hash, u32 slot) {
+	u32 mask = table.count - 1;
+	u32 position = hash & mask;
+	while (table[position] != slot) {
+		CUSTOM_ASSERT(table[position] != custom::empty_index, "asset index is corrupted");
+		position = (position + 1) & mask;
+	}
+	return position;
+}
+
+// @Note: backward shift deletion keeps probe sequences intact without tombstones
+static void index_erase(Array<u32> & table, slot_hash_func * hash, u32 slot) {
+	u32 mask = table.count - 1;
+	u32 position = index_locate(table, (*hash)(slot), slot);
+	for (u32 next = (position + 1) & mask; table[next] != custom::empty_index; next = (next + 1) & mask) {
+		u32 home = (*hash)(table[next]) & mask;
+		// @Note: an entry can move back unless its home lies cyclically in `(position, next]`
+		bool stays = (position <= next)
+			? (position < home && home <= next)
+			: (position < home || home <= next);
+		if (stays) { continue; }
+		table[position] = table[next];
+		position = next;
+	}
+	table[position] = custom::empty_index;
+}
+
+static void index_rebuild(u32 capacity) {
+	Array<u32> * tables[]     = {&Asset::state.key_index, &Asset::state.resource_index};
+	slot_hash_func * hashes[] = {&slot_key_hash,          &slot_resource_hash};
+	for (u32 t = 0; t < C_ARRAY_LENGTH(tables); ++t) {
+		Array<u32> & table = *tables[t];
+		table.set_capacity(capacity);
+		table.count = capacity;
+		memset(table.data, 0xff, capacity * sizeof(u32));
+		for (u32 slot = 0; slot < Asset::state.instance_refs.count; ++slot) {
+			index_insert(table, (*hashes[t])(slot), slot);
+		}
+	}
+}
+
+static void state_push(Ref const & ref, u32 resource, u32 type, Asset::Status status) {
+	Asset::state.instance_refs.push(ref);
+	Asset::state.resources.push(resource);
+	Asset::state.types.push(type);
+	Asset::state.statuses.push(status);
+	Asset::state.ref_counts.push(0);
+	Asset::state.idle_since.push(custom::empty_index);
+
+	u32 slot = Asset::state.instance_refs.count - 1;
+	u32 capacity = Asset::state.key_index.count;
+	if ((slot + 1) * 4 > capacity * 3) {
+		index_rebuild(capacity ? capacity * 2 : 16);
+		return;
+	}
+	index_insert(Asset::state.key_index, slot_key_hash(slot), slot);
+	index_insert(Asset::state.resource_index, slot_resource_hash(slot), slot);
+}
+
+// @Note: mirrors `Array::remove_at`, which moves the last slot into the removed one
+static void state_remove_at(u32 slot) {
+	index_erase(Asset::state.key_index, &slot_key_hash, slot);
+	index_erase(Asset::state.resource_index, &slot_resource_hash, slot);
+
+	u32 last = Asset::state.instance_refs.count - 1;
+	if (slot != last) {
+		Asset::state.key_index[index_locate(Asset::state.key_index, slot_key_hash(last), last)] = slot;
+		Asset::state.resource_index[index_locate(Asset::state.resource_index, slot_resource_hash(last), last)] = slot;
+	}
+
+	Asset::state.instance_refs.remove_at(slot);
+	Asset::state.resources.remove_at(slot);
+	Asset::state.types.remove_at(slot);
+	Asset::state.statuses.remove_at(slot);
+	Asset::state.ref_counts.remove_at(slot);
+	Asset::state.idle_since.remove_at(slot);
+}
+
+static u32 find(u32 type, u32 resource) {
+	Array<u32> const & table = Asset::state.key_index;
+	if (!table.count) { return custom::empty_index; }
+
+	u32 mask = table.count - 1;
+	for (u32 position = key_hash(type, resource) & mask; table[position] != custom::empty_index; position = (position + 1) & mask) {
+		u32 slot = table[position];
+		if (Asset::state.types[slot] != type) { continue; }
+		if (Asset::state.resources[slot] == resource) { return slot; }
+	}
+	return custom::empty_index;
+}
+
+static void find_by_resource(u32 resource, Array<Asset> & out) {
+	Array<u32> const & table = Asset::state.resource_index;
+	if (!table.count) { return; }
+
+	u32 mask = table.count - 1;
+	for (u32 position = resource_hash(resource) & mask; table[position] != custom::empty_index; position = (position + 1) & mask) {
+		u32 slot = table[position];
+		if (Asset::state.resources[slot] != resource) { continue; }
+		out.push({Asset::state.instance_refs[slot], resource, Asset::state.types[slot]});
+	}
+}
 
 }
 
@@ -25,16 +167,20 @@ Strings_Storage Asset::strings;
 
 namespace custom {
 
+inline static Strings_Storage & get_strings(void) {
+	return Asset::staging ? Asset::staging->strings : Asset::strings;
+}
+
 u32 Asset::store_string(cstring data, u32 length) {
-	return Asset::strings.store_string(data, length);
+	return get_strings().store_string(data, length);
 }
 
 u32 Asset::get_id(cstring data, u32 length) {
-	return Asset::strings.get_id(data, length);
+	return get_strings().get_id(data, length);
 }
 
 cstring Asset::get_string(u32 id) {
-	return Asset::strings.get_string(id);
+	return get_strings().get_string(id);
 }
 
 }
@@ -45,12 +191,7 @@ cstring Asset::get_string(u32 id) {
 
 namespace custom {
 
-static u32 find_by_resource(u32 resource) {
-	for (u32 i = 0; i < Asset::state.types.count; ++i) {
-		if (Asset::state.resources[i] == resource) { return i; }
-	}
-	return custom::empty_index;
-}
+static void async_retry(Asset const & asset);
 
 void Asset::update(void) {
 	typedef custom::file::Action_Type Action_Type;
@@ -66,10 +207,15 @@ void Asset::update(void) {
 
 			case Action_Type::Mod: {
 				u32 resource = Asset::strings.get_id(string, length);
-				u32 index = find_by_resource(resource);
-				if (index != custom::empty_index) {
-					Asset asset = {Asset::state.instance_refs[index], Asset::state.resources[index], Asset::state.types[index]};
-					(*Asset::vtable.update[asset.type])(asset);
+				// @Note: a file can back assets of several types
+				Array<Asset> assets;
+				find_by_resource(resource, assets);
+				for (u32 asset_i = 0; asset_i < assets.count; ++asset_i) {
+					// @Note: a pending asset will read the file anew anyway
+					if (assets[asset_i].is_pending()) { continue; }
+					// @Note: a failed asset has nothing to update, so decode it anew
+					if (assets[asset_i].is_failed()) { async_retry(assets[asset_i]); continue; }
+					(*Asset::vtable.update[assets[asset_i].type])(assets[asset_i]);
 				}
 			} break;
 
@@ -81,6 +227,182 @@ void Asset::update(void) {
 
 }
 
+//
+// asynchronous loading
+//
+
+namespace custom {
+
+struct Async_Data {
+	Array<Asset> queue; // pending, yet to be handed to the workers
+
+	// in flight
+	Array<Asset>  assets;
+	Array<void *> decoded;
+	Array<char>   paths;
+	Array<u32>    path_offsets;
+	thread::Background_Task * task;
+};
+
+static Async_Data async_data;
+
+inline static u32 find_slot(Asset const & asset) {
+	u32 index = find(asset.type, asset.resource);
+	if (index == custom::empty_index) { return custom::empty_index; }
+	if (Asset::state.instance_refs[index] != asset) { return custom::empty_index; }
+	return index;
+}
+
+inline static bool has_status_slot(Asset const & asset, Asset::Status status) {
+	u32 index = find_slot(asset);
+	if (index == custom::empty_index) { return false; }
+	return Asset::state.statuses[index] == status;
+}
+
+inline static bool is_pending_slot(Asset const & asset) {
+	return has_status_slot(asset, Asset::Status::Pending);
+}
+
+// @Note: a call per asset of the batch, so that each one owns its output slot
+static THREAD_TASK_FUNC(async_decode_task) {
+	cstring path = async_data.paths.data + async_data.path_offsets[index];
+	async_data.decoded[index] = (*Asset::vtable.decode[async_data.assets[index].type])(path);
+}
+
+static void async_retry(Asset const & asset) {
+	Asset::state.statuses[find_slot(asset)] = Asset::Status::Pending;
+	async_data.queue.push(asset);
+}
+
+static void async_batch_start(void) {
+	for (u32 i = 0; i < async_data.queue.count; ++i) {
+		Asset const & asset = async_data.queue[i];
+		// @Note: removed or overtaken by a synchronous load meanwhile
+		if (!is_pending_slot(asset)) { continue; }
+
+		cstring path = Asset::get_string(asset.resource);
+		async_data.assets.push(asset);
+		async_data.decoded.push(NULL);
+		async_data.path_offsets.push(async_data.paths.count);
+		async_data.paths.push_range(path, (u32)strlen(path) + 1);
+	}
+	async_data.queue.count = 0;
+	if (!async_data.assets.count) { return; }
+
+	async_data.task = thread::start_on_workers(&async_decode_task, NULL, async_data.assets.count);
+}
+
+static void async_batch_finish(void) {
+	if (async_data.task) {
+		thread::join(async_data.task);
+		async_data.task = NULL;
+	}
+
+	for (u32 i = 0; i < async_data.assets.count; ++i) {
+		Asset asset = async_data.assets[i];
+		if (is_pending_slot(asset)) {
+			// @Note: a failed asset stays empty, but it's being retried on modification
+			Asset::state.statuses[find_slot(asset)] = async_data.decoded[i] ? Asset::Status::Loaded : Asset::Status::Failed;
+		}
+		else {
+			// @Note: an empty ref makes the type discard the result
+			asset.id  = custom::empty_ref.id;
+			asset.gen = custom::empty_ref.gen;
+		}
+		(*Asset::vtable.apply[asset.type])(asset, async_data.decoded[i]);
+	}
+
+	async_data.assets.count = 0;
+	async_data.decoded.count = 0;
+	async_data.paths.count = 0;
+	async_data.path_offsets.count = 0;
+}
+
+void Asset::apply_async(void) {
+	if (async_data.task && !thread::is_done(async_data.task)) { return; }
+	async_batch_finish();
+	async_batch_start();
+}
+
+void Asset::wait_async(void) {
+	while (async_data.task || async_data.queue.count) {
+		async_batch_finish();
+		async_batch_start();
+	}
+}
+
+}
+
+//
+// usage tracking
+//
+
+namespace custom {
+
+struct Usage_Data {
+	Array<Asset> idle; // awaiting collection; see `Asset::State::idle_since`
+	u32          frame;
+	u32          grace_frames = 120;
+};
+
+static Usage_Data usage_data;
+
+void Asset::set_grace_period(u32 frames) {
+	usage_data.grace_frames = frames;
+}
+
+void Asset::collect_unused(void) {
+	++usage_data.frame;
+	for (u32 i = 0; i < usage_data.idle.count; /**/) {
+		Asset asset = usage_data.idle[i];
+
+		u32 index = find_slot(asset);
+		if (index == custom::empty_index) { usage_data.idle.remove_at(i); continue; }
+
+		// @Note: has been acquired anew
+		if (Asset::state.ref_counts[index]) {
+			Asset::state.idle_since[index] = custom::empty_index;
+			usage_data.idle.remove_at(i); continue;
+		}
+
+		if (usage_data.frame - Asset::state.idle_since[index] < usage_data.grace_frames) { ++i; continue; }
+
+		usage_data.idle.remove_at(i);
+		asset.destroy();
+	}
+}
+
+// @Note: a staging thread mustn't touch shared state; its refs are empty anyway
+void Asset::acquire(void) const {
+	if (Asset::staging) { return; }
+
+	u32 index = find_slot(*this);
+	if (index == custom::empty_index) { return; }
+
+	++Asset::state.ref_counts[index];
+}
+
+void Asset::release(void) const {
+	if (Asset::staging) { return; }
+
+	u32 index = find_slot(*this);
+	if (index == custom::empty_index) { return; }
+
+	if (!Asset::state.ref_counts[index]) { CUSTOM_ASSERT(false, "asset hasn't been acquired"); return; }
+	if (--Asset::state.ref_counts[index]) { return; }
+
+	if (Asset::state.idle_since[index] == custom::empty_index) { usage_data.idle.push(*this); }
+	Asset::state.idle_since[index] = usage_data.frame;
+}
+
+u32 Asset::get_ref_count(void) const {
+	u32 index = find_slot(*this);
+	if (index == custom::empty_index) { return 0; }
+	return Asset::state.ref_counts[index];
+}
+
+}
+
 //
 // asset ref
 //
@@ -88,12 +410,9 @@ void Asset::update(void) {
 namespace custom {
 
 inline static u32 is_correct(Asset const & asset) {
-	for (u32 i = 0; i < Asset::state.types.count; ++i) {
-		if (Asset::state.types[i] != asset.type) { continue; }
-		if (Asset::state.resources[i] != asset.resource) { continue; }
-		if (Asset::state.instance_refs[i] == asset) { return true; }
-	}
-	return false;
+	u32 index = find(asset.type, asset.resource);
+	if (index == custom::empty_index) { return false; }
+	return Asset::state.instance_refs[index] == asset;
 }
 
 cstring Asset::get_path(void) const {
@@ -106,23 +425,27 @@ bool Asset::exists(void) const {
 	return (*Asset::vtable.contains[type])(*this);
 }
 
+bool Asset::is_pending(void) const {
+	return is_pending_slot(*this);
+}
+
+bool Asset::is_failed(void) const {
+	return has_status_slot(*this, Asset::Status::Failed);
+}
+
 void Asset::destroy(void) {
 	// @Note: duplicates `Asset::rem` code
 	CUSTOM_ASSERT(is_correct(*this), "asset ref is corrupted");
 	if ((*Asset::vtable.contains[type])(*this)) {
-		(*Asset::vtable.unload[type])(*this);
+		// @Note: a pending or a failed asset has nothing to unload
+		if (!is_pending() && !is_failed()) { (*Asset::vtable.unload[type])(*this); }
 		(*Asset::vtable.destroy[type])(*this);
 	}
 	else { CUSTOM_ASSERT(false, "asset doesn't exist"); }
 
-	for (u32 i = 0; i < Asset::state.instance_refs.count; ++i) {
-		if (Asset::state.types[i] != type) { continue; }
-		if (Asset::state.resources[i] != resource) { continue; }
-		if (Asset::state.instance_refs[i] != *this) { continue; }
-		Asset::state.instance_refs.remove_at(i);
-		Asset::state.resources.remove_at(i);
-		Asset::state.types.remove_at(i);
-		break;
+	u32 index = find(type, resource);
+	if (index != custom::empty_index && Asset::state.instance_refs[index] == *this) {
+		state_remove_at(index);
 	}
 }
 
@@ -134,14 +457,6 @@ void Asset::destroy(void) {
 
 namespace custom {
 
-static u32 find(u32 type, u32 resource) {
-	for (u32 i = 0; i < Asset::state.types.count; ++i) {
-		if (Asset::state.types[i] != type) { continue; }
-		if (Asset::state.resources[i] == resource) { return i; }
-	}
-	return custom::empty_index;
-}
-
 void Asset::reset_system(u32 type) {
 	Array<Asset> instances_of_type;
 	for (u32 i = 0; i < Asset::state.instance_refs.count; ++i) {
@@ -159,9 +474,15 @@ void Asset::reset_system(u32 type) {
 	}
 }
 
-Asset Asset::add(u32 type, u32 resource) {
+static Asset add_impl(u32 type, u32 resource, bool is_async) {
 	Asset asset = {custom::empty_ref, resource, type};
 
+	if (Asset::staging) {
+		Asset::staging->types.push(type);
+		Asset::staging->resources.push(resource);
+		return asset;
+	}
+
 	u32 index = find(type, resource);
 	if (index != custom::empty_index) {
 		Ref asset_ref = Asset::state.instance_refs[index];
@@ -170,19 +491,27 @@ Asset Asset::add(u32 type, u32 resource) {
 	}
 
 	if (asset.id == custom::empty_ref.id || !(*Asset::vtable.contains[type])(asset)) {
-		if (index != custom::empty_index) {
-			Asset::state.instance_refs.remove_at(index);
-			Asset::state.resources.remove_at(index);
-			Asset::state.types.remove_at(index);
-		}
+		if (index != custom::empty_index) { state_remove_at(index); }
 
 		Ref asset_ref = (*Asset::vtable.create[type])();
 		asset.id  = asset_ref.id;
 		asset.gen = asset_ref.gen;
-		Asset::state.instance_refs.push(asset);
-		Asset::state.resources.push(resource);
-		Asset::state.types.push(type);
 
+		if (is_async) {
+			// @Note: applying nothing zeroes the asset, so a pending one reads as empty
+			state_push(asset, resource, type, Asset::Status::Pending);
+			(*Asset::vtable.apply[type])(asset, NULL);
+			async_data.queue.push(asset);
+		}
+		else {
+			state_push(asset, resource, type, Asset::Status::Loaded);
+			(*Asset::vtable.load[type])(asset);
+		}
+	}
+	else if (!is_async && Asset::state.statuses[index] != Asset::Status::Loaded) {
+		// @Note: a synchronous request overtakes the asynchronous one, which will be discarded,
+		//        or retries the failed one
+		Asset::state.statuses[index] = Asset::Status::Loaded;
 		(*Asset::vtable.load[type])(asset);
 	}
 	// @Todo: check explicitly?
@@ -191,22 +520,31 @@ Asset Asset::add(u32 type, u32 resource) {
 	return asset;
 }
 
+Asset Asset::add(u32 type, u32 resource) {
+	return add_impl(type, resource, false);
+}
+
+Asset Asset::add_async(u32 type, u32 resource) {
+	// @Note: types without a decoder are loaded synchronously
+	return add_impl(type, resource, Asset::vtable.decode[type] != NULL);
+}
+
 void Asset::rem(u32 type, u32 resource) {
 	// @Note: duplicates `Asset::destroy` code
 	Asset asset = {custom::empty_ref, resource, type};
 
+	bool is_loaded = true;
 	u32 index = find(type, resource);
 	if (index != custom::empty_index) {
 		Ref asset_ref = Asset::state.instance_refs[index];
 		asset.id  = asset_ref.id;
 		asset.gen = asset_ref.gen;
-		Asset::state.instance_refs.remove_at(index);
-		Asset::state.resources.remove_at(index);
-		Asset::state.types.remove_at(index);
+		is_loaded = Asset::state.statuses[index] == Asset::Status::Loaded;
+		state_remove_at(index);
 	}
 
 	if ((*Asset::vtable.contains[type])(asset)) {
-		(*Asset::vtable.unload[type])(asset);
+		if (is_loaded) { (*Asset::vtable.unload[type])(asset); }
 		(*Asset::vtable.destroy[type])(asset);
 	}
 	else { CUSTOM_ASSERT(false, "asset doesn't exist"); }
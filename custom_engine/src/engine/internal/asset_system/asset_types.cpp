@@ -2,27 +2,96 @@
 
 #include "engine/core/code.h"
 #include "engine/debug/log.h"
+#include "engine/api/platform/thread.h"
 #include "engine/api/internal/asset_system.h"
 #include "engine/api/internal/asset_types.h"
 #include "engine/api/internal/parsing.h"
 #include "engine/impl/array.h"
+#include "engine/impl/bytecode.h"
+#include "engine/impl/math_hashing.h"
 #include "engine/impl/parsing.h"
 
 #include "obj_parser.h"
+#include "mesh_optimizer.h"
 
 #include <stb_image.h>
 
+//
+// cooked files
+//
+
+namespace custom {
+
+#define COOKED_MAGIC(a, b, c) (((u32)(a) << 8) | ((u32)(b) << 16) | ((u32)(c) << 24))
+constexpr static u32 const cooked_version = 1;
+
+constexpr static u32 const cooked_magic_texture    = COOKED_MAGIC('T', 'E', 'X');
+constexpr static u32 const cooked_magic_mesh       = COOKED_MAGIC('M', 'S', 'H');
+constexpr static u32 const cooked_magic_collider2d = COOKED_MAGIC('C', '2', 'D');
+
+static void write_cooked_header(Bytecode & bc, u32 magic) {
+	bc.write(Cooked_Header{magic, cooked_version});
+}
+
+// @Note: reads a cooked file in place; the buffer is borrowed, not owned
+struct Cooked_Reader {
+	Bytecode bc;
+
+	~Cooked_Reader(void) {
+		bc.buffer.data = NULL;
+		bc.buffer.capacity = bc.buffer.count = 0;
+	}
+
+	// @Note: returns whether the file is a cooked one; leaves `bc` empty if it's outdated
+	bool open(file::View file, u32 magic) {
+		if (file.count < sizeof(Cooked_Header)) { return false; }
+
+		Cooked_Header const * header = (Cooked_Header const *)file.data;
+		if (header->magic != magic) { return false; }
+		if (header->version != cooked_version) {
+			CUSTOM_ASSERT(false, "cooked file version is %u instead of %u; recook assets", header->version, cooked_version);
+			return true;
+		}
+		if (file.count > UINT32_MAX) { CUSTOM_ASSERT(false, "cooked file is too large"); return true; }
+
+		bc.buffer.data     = (u8 *)file.data;
+		bc.buffer.capacity = (u32)file.count;
+		bc.buffer.count    = (u32)file.count;
+		bc.read_offset = 0;
+
+		bc.read<Cooked_Header>();
+		return true;
+	}
+};
+
+template<typename T>
+static void write_array(Bytecode & bc, Array<T> const & array) {
+	bc.write(array.count);
+	if (array.count) { bc.write(array.data, array.count); }
+}
+
+template<typename T>
+static void read_array(Bytecode const & bc, Array<T> & array) {
+	u32 count = *bc.read<u32>();
+	array.set_capacity(count);
+	if (count) { bc.copy(array.data, count); }
+	array.count = count;
+}
+
+}
+
 //
 // Shader_Asset
 //
 
 namespace custom {
 
-void Shader_Asset::update(Array<u8> & file) {
-	file.push('\0'); --file.count;
-	source.data     = file.data;     file.data     = NULL;
-	source.capacity = file.capacity; file.capacity = 0;
-	source.count    = file.count;    file.count    = 0;
+void Shader_Asset::update(file::View file) {
+	if (file.count >= UINT32_MAX) { CUSTOM_ASSERT(false, "shader is too large"); return; }
+	source.set_capacity((u32)file.count + 1);
+	source.count = 0;
+	source.push_range(file.data, (u32)file.count);
+	source.push('\0'); --source.count;
 }
 
 }
@@ -33,7 +102,34 @@ void Shader_Asset::update(Array<u8> & file) {
 
 namespace custom {
 
-void Texture_Asset::update(Array<u8> & file) {
+void Texture_Asset::cook(Bytecode & bc) const {
+	write_cooked_header(bc, cooked_magic_texture);
+	bc.write(size);
+	bc.write(channels);
+	bc.write(is_dynamic);
+	bc.write(data_type);
+	bc.write(texture_type);
+	bc.write(min_tex); bc.write(min_mip); bc.write(mag_tex);
+	bc.write(wrap_x); bc.write(wrap_y);
+	write_array(bc, data);
+}
+
+void Texture_Asset::update(file::View file) {
+	Cooked_Reader reader;
+	if (reader.open(file, cooked_magic_texture)) {
+		Bytecode const & bc = reader.bc;
+		if (!bc.buffer.count) { return; }
+		bc.copy(&size);
+		bc.copy(&channels);
+		bc.copy(&is_dynamic);
+		bc.copy(&data_type);
+		bc.copy(&texture_type);
+		bc.copy(&min_tex); bc.copy(&min_mip); bc.copy(&mag_tex);
+		bc.copy(&wrap_x); bc.copy(&wrap_y);
+		read_array(bc, data);
+		return;
+	}
+
 	// @Todo: read meta or provide these otherwise
 	is_dynamic = false;
 	data_type = graphics::Data_Type::u8;
@@ -47,26 +143,33 @@ void Texture_Asset::update(Array<u8> & file) {
 
 	u8 data_type_size = 0;
 
-	stbi_set_flip_vertically_on_load(1);
+	// @Note: textures are being decoded on several threads at once
+	stbi_set_flip_vertically_on_load_thread(1);
 	switch (data_type)
 	{
 		case custom::graphics::Data_Type::u8:
 			data_type_size = sizeof(u8);
-			data.data = (u8 *)stbi_load_from_memory(file.data, file.count, &size.x, &size.y, &channels, 0);
+			data.data = (u8 *)stbi_load_from_memory(file.data, (int)file.count, &size.x, &size.y, &channels, 0);
 			break;
 		case custom::graphics::Data_Type::u16:
 			data_type_size = sizeof(u16);
-			data.data = (u8 *)stbi_load_16_from_memory(file.data, file.count, &size.x, &size.y, &channels, 0);
+			data.data = (u8 *)stbi_load_16_from_memory(file.data, (int)file.count, &size.x, &size.y, &channels, 0);
 			break;
 		case custom::graphics::Data_Type::r32:
 			data_type_size = sizeof(r32);
-			data.data = (u8 *)stbi_loadf_from_memory(file.data, file.count, &size.x, &size.y, &channels, 0);
+			data.data = (u8 *)stbi_loadf_from_memory(file.data, (int)file.count, &size.x, &size.y, &channels, 0);
 			break;
 		default:
 			CUSTOM_ASSERT(false, "texture data type is not supported: %d", (u8)data_type);
 			break;
 	}
 
+	if (!data.data) {
+		CUSTOM_WARNING("failed to decode texture");
+		data.capacity = data.count = 0;
+		return;
+	}
+
 	data.capacity = size.x * size.y * channels * data_type_size;
 	data.count = data.capacity;
 }
@@ -81,8 +184,98 @@ namespace custom {
 
 template struct Array<Mesh_Asset::Buffer>;
 
-void Mesh_Asset::update(Array<u8> & file) {
-	file.push('\0'); --file.count;
+// @Note: takes ownership of the arrays
+template<typename T>
+static void push_mesh_buffer(Array<Mesh_Asset::Buffer> & buffers, Array<u8> & attributes, Array<T> & data, graphics::Data_Type data_type, bool is_index) {
+	buffers.push();
+	Mesh_Asset::Buffer & buffer = buffers[buffers.count - 1];
+
+	buffer.attributes.data     = attributes.data;     attributes.data     = NULL;
+	buffer.attributes.capacity = attributes.capacity; attributes.capacity = 0;
+	buffer.attributes.count    = attributes.count;    attributes.count    = 0;
+
+	buffer.buffer.data     = (u8 *)data.data;           data.data     = NULL;
+	buffer.buffer.capacity = data.capacity * sizeof(T); data.capacity = 0;
+	buffer.buffer.count    = data.count * sizeof(T);    data.count    = 0;
+
+	buffer.data_type = data_type;
+	buffer.is_index = is_index;
+
+	// @Todo: read meta or provide these otherwise
+	buffer.frequency = graphics::Mesh_Frequency::Static;
+	buffer.access = graphics::Mesh_Access::Draw;
+}
+
+#if defined(MESH_QUANTIZE_ATTRIBUTES)
+// @Note: positions stay as they are; the rest, e.g. texture coordinates and normals,
+//        can be quantized unless they exceed the normalized range
+static bool can_quantize_attributes(Array<u8> const & attributes, u32 elements_per_vertex, Array<r32> const & vertices) {
+	if (attributes.count < 2) { return false; }
+
+	for (u32 i = 0; i < vertices.count; i += elements_per_vertex) {
+		for (u32 element = attributes[0]; element < elements_per_vertex; ++element) {
+			r32 value = vertices[i + element];
+			if (value < -1.0f || value > 1.0f) { return false; }
+		}
+	}
+	return true;
+}
+
+// @Note: splits off attributes past positions into a normalized `s16` buffer
+static void quantize_attributes(Array<u8> & attributes, u32 elements_per_vertex, Array<r32> & vertices, Array<u8> & quantized_attributes, Array<s16> & quantized) {
+	u32 position_elements = attributes[0];
+	u32 vertices_count = vertices.count / elements_per_vertex;
+
+	quantized_attributes.push_range(attributes.data + 1, attributes.count - 1);
+	attributes.count = 1;
+
+	quantized.set_capacity(vertices_count * (elements_per_vertex - position_elements));
+	for (u32 i = 0; i < vertices_count; ++i) {
+		r32 const * vertex = vertices.data + i * elements_per_vertex;
+		for (u32 element = position_elements; element < elements_per_vertex; ++element) {
+			quantized.push((s16)roundf(vertex[element] * 32767.0f));
+		}
+		memmove(vertices.data + i * position_elements, vertex, position_elements * sizeof(r32));
+	}
+	vertices.count = vertices_count * position_elements;
+}
+#endif
+
+void Mesh_Asset::cook(Bytecode & bc) const {
+	write_cooked_header(bc, cooked_magic_mesh);
+	bc.write(buffers.count);
+	for (u32 i = 0; i < buffers.count; ++i) {
+		Mesh_Asset::Buffer const & buffer = buffers[i];
+		bc.write(buffer.is_index);
+		bc.write(buffer.data_type);
+		bc.write(buffer.frequency);
+		bc.write(buffer.access);
+		write_array(bc, buffer.attributes);
+		write_array(bc, buffer.buffer);
+	}
+}
+
+void Mesh_Asset::update(file::View file) {
+	Cooked_Reader reader;
+	if (reader.open(file, cooked_magic_mesh)) {
+		Bytecode const & bc = reader.bc;
+		if (!bc.buffer.count) { return; }
+		u32 count = *bc.read<u32>();
+		buffers.set_capacity(count);
+		for (u32 i = 0; i < count; ++i) {
+			buffers.push();
+			Mesh_Asset::Buffer & buffer = buffers[i];
+			buffer.attributes.data = NULL; buffer.attributes.capacity = 0; buffer.attributes.count = 0;
+			buffer.buffer.data     = NULL; buffer.buffer.capacity     = 0; buffer.buffer.count     = 0;
+			bc.copy(&buffer.is_index);
+			bc.copy(&buffer.data_type);
+			bc.copy(&buffer.frequency);
+			bc.copy(&buffer.access);
+			read_array(bc, buffer.attributes);
+			read_array(bc, buffer.buffer);
+		}
+		return;
+	}
 
 	Array<u8> attributes;
 	Array<r32> vertices;
@@ -91,47 +284,43 @@ void Mesh_Asset::update(Array<u8> & file) {
 	if (!attributes.count) { CUSTOM_ASSERT(false, "mesh has no attributes"); return; }
 	if (!vertices.count) { CUSTOM_ASSERT(false, "mesh has no vertices"); return; }
 	if (!indices.count) { CUSTOM_ASSERT(false, "mesh has no indices"); return; }
-	
-	buffers.set_capacity(2);
 
-	{
-		buffers.push();
-		Mesh_Asset::Buffer & buffer = buffers[0];
-	
-		buffer.attributes.data     = attributes.data;     attributes.data     = NULL;
-		buffer.attributes.capacity = attributes.capacity; attributes.capacity = 0;
-		buffer.attributes.count    = attributes.count;    attributes.count    = 0;
-
-		buffer.buffer.data     = (u8 *)vertices.data;             vertices.data     = NULL;
-		buffer.buffer.capacity = vertices.capacity * sizeof(r32); vertices.capacity = 0;
-		buffer.buffer.count    = vertices.count * sizeof(r32);    vertices.count    = 0;
-
-		buffer.data_type = graphics::Data_Type::r32;
-		buffer.is_index = false;
-
-		// @Todo: read meta or provide these otherwise
-		buffer.frequency = graphics::Mesh_Frequency::Static;
-		buffer.access = graphics::Mesh_Access::Draw;
+	u32 elements_per_vertex = 0;
+	for (u32 i = 0; i < attributes.count; ++i) {
+		elements_per_vertex += attributes[i];
 	}
 
+	mesh::optimize_vertex_cache(indices, vertices.count / elements_per_vertex);
+	mesh::optimize_vertex_fetch(vertices, elements_per_vertex, indices);
+	u32 vertices_count = vertices.count / elements_per_vertex;
+
+	buffers.set_capacity(3);
+
+#if defined(MESH_QUANTIZE_ATTRIBUTES)
+	if (can_quantize_attributes(attributes, elements_per_vertex, vertices)) {
+		Array<u8> quantized_attributes;
+		Array<s16> quantized;
+		quantize_attributes(attributes, elements_per_vertex, vertices, quantized_attributes, quantized);
+		push_mesh_buffer(buffers, attributes, vertices, graphics::Data_Type::r32, false);
+		push_mesh_buffer(buffers, quantized_attributes, quantized, graphics::Data_Type::s16, false);
+	}
+	else
+#endif
 	{
-		buffers.push();
-		Mesh_Asset::Buffer & buffer = buffers[1];
-	
-		buffer.attributes.data     = NULL;
-		buffer.attributes.capacity = 0;
-		buffer.attributes.count    = 0;
-
-		buffer.buffer.data     = (u8 *)indices.data;             indices.data     = NULL;
-		buffer.buffer.capacity = indices.capacity * sizeof(u32); indices.capacity = 0;
-		buffer.buffer.count    = indices.count * sizeof(u32);    indices.count    = 0;
-
-		buffer.data_type = graphics::Data_Type::u32;
-		buffer.is_index = true;
-
-		// @Todo: read meta or provide these otherwise
-		buffer.frequency = graphics::Mesh_Frequency::Static;
-		buffer.access = graphics::Mesh_Access::Draw;
+		push_mesh_buffer(buffers, attributes, vertices, graphics::Data_Type::r32, false);
+	}
+
+	// @Note: halve the index buffer whenever vertices allow it
+	Array<u8> no_attributes;
+	if (vertices_count < (1 << 16)) {
+		Array<u16> narrow_indices(indices.count);
+		for (u32 i = 0; i < indices.count; ++i) {
+			narrow_indices.push((u16)indices[i]);
+		}
+		push_mesh_buffer(buffers, no_attributes, narrow_indices, graphics::Data_Type::u16, true);
+	}
+	else {
+		push_mesh_buffer(buffers, no_attributes, indices, graphics::Data_Type::u32, true);
 	}
 }
 
@@ -151,8 +340,19 @@ Mesh_Asset::~Mesh_Asset() {
 
 namespace custom {
 
-void Collider2d_Asset::update(Array<u8> & file) {
-	file.push('\0'); --file.count;
+void Collider2d_Asset::cook(Bytecode & bc) const {
+	write_cooked_header(bc, cooked_magic_collider2d);
+	write_array(bc, points);
+}
+
+void Collider2d_Asset::update(file::View file) {
+	Cooked_Reader reader;
+	if (reader.open(file, cooked_magic_collider2d)) {
+		Bytecode const & bc = reader.bc;
+		if (!bc.buffer.count) { return; }
+		read_array(bc, points);
+		return;
+	}
 
 	cstring source;
 
@@ -172,7 +372,7 @@ void Collider2d_Asset::update(Array<u8> & file) {
 
 	if (!vertices.count) { CUSTOM_ASSERT(false, "mesh has no vertices"); return; }
 
-	points.set_capacity(vertices.count);
+	points.set_capacity(0);
 	points.data     = vertices.data;     vertices.data     = NULL;
 	points.capacity = vertices.capacity; vertices.capacity = 0;
 	points.count    = vertices.count;    vertices.count    = 0;
@@ -262,9 +462,7 @@ template<> cstring Config_Asset::get_value<cstring>(cstring key, cstring default
 }
 
 //
-void Config_Asset::update(Array<u8> & file) {
-	file.push('\0'); --file.count;
-
+void Config_Asset::update(file::View file) {
 	static u32 const type_s32 = Asset::store_string("s32", custom::empty_index);
 	static u32 const type_u32 = Asset::store_string("u32", custom::empty_index);
 	static u32 const type_r32 = Asset::store_string("r32", custom::empty_index);
@@ -9,19 +9,19 @@
 #define ASSET_IMPL(T) typedef custom::T T;
 #include "engine/registry_impl/asset_types.h"
 
-#define ASSET_IMPL(T)                         \
-template struct custom::Array<T>;             \
-template struct custom::RefT<T>;              \
-template struct custom::Asset_RefT<T>;        \
+#define ASSET_IMPL(T)                  \
+template struct custom::Array<T>;      \
+template struct custom::RefT<T>;       \
+template struct custom::Asset_RefT<T>; \
 
 #include "engine/registry_impl/asset_types.h"
 
 namespace custom {
 
-#define ASSET_IMPL(T)                                                               \
-static REF_VOID_FUNC(ref_pool_create_##T) { return RefT<T>::pool.create(); }        \
-static VOID_REF_FUNC(ref_pool_destroy_##T) { RefT<T>::pool.destroy(ref); }          \
-static BOOL_REF_FUNC(ref_pool_contains_##T) { return RefT<T>::pool.contains(ref); } \
+#define ASSET_IMPL(T)                                                                     \
+static REF_VOID_FUNC(ref_pool_create_##T) { return RefT<T>::get_pool().create(); }        \
+static VOID_REF_FUNC(ref_pool_destroy_##T) { RefT<T>::get_pool().destroy(ref); }          \
+static BOOL_REF_FUNC(ref_pool_contains_##T) { return RefT<T>::get_pool().contains(ref); } \
 
 #include "engine/registry_impl/asset_types.h"
 
@@ -53,6 +53,8 @@ void init_asset_types(void) {
 	custom::Asset::vtable.load.set_capacity(custom::asset_names.get_count());
 	custom::Asset::vtable.unload.set_capacity(custom::asset_names.get_count());
 	custom::Asset::vtable.update.set_capacity(custom::asset_names.get_count());
+	custom::Asset::vtable.decode.set_capacity(custom::asset_names.get_count());
+	custom::Asset::vtable.apply.set_capacity(custom::asset_names.get_count());
 
 	#define ASSET_IMPL(T)                                                       \
 	custom::Asset::vtable.create.push(&custom::ref_pool_create_##T);            \
@@ -61,6 +63,19 @@ void init_asset_types(void) {
 	custom::Asset::vtable.load.push(&custom::loading::asset_pool_load_##T);     \
 	custom::Asset::vtable.unload.push(&custom::loading::asset_pool_unload_##T); \
 	custom::Asset::vtable.update.push(&custom::loading::asset_pool_update_##T); \
+	custom::Asset::vtable.decode.push(NULL);                                    \
+	custom::Asset::vtable.apply.push(NULL);                                     \
 
 	#include "engine/registry_impl/asset_types.h"
+
+	// @Note: these types decode without touching shared state, so can be loaded asynchronously
+	#define ASSET_IMPL(T)                                                                                    \
+	custom::Asset::vtable.decode[custom::Asset_Registry<T>::type] = &custom::loading::asset_pool_decode_##T; \
+	custom::Asset::vtable.apply[custom::Asset_Registry<T>::type]  = &custom::loading::asset_pool_apply_##T;  \
+
+	ASSET_IMPL(Shader_Asset)
+	ASSET_IMPL(Texture_Asset)
+	ASSET_IMPL(Mesh_Asset)
+	ASSET_IMPL(Collider2d_Asset)
+	#undef ASSET_IMPL
 }
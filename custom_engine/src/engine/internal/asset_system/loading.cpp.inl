@@ -5,6 +5,7 @@
 #include "engine/core/math_types.h"
 #include "engine/debug/log.h"
 #include "engine/api/platform/file.h"
+#include "engine/api/internal/asset_pack.h"
 #include "engine/api/internal/names_lookup.h"
 #include "engine/api/internal/asset_types.h"
 #include "engine/impl/array.h"
@@ -13,16 +14,70 @@
 
 namespace custom {
 
+// @Note: contents of an asset file: a view into the pack, a mapped loose file, or
+//        `buffer`, if the mapping lacks a terminating zero; see `file::map`
+struct Asset_File {
+	file::View view;
+	Array<u8>  buffer;
+	b8         is_mapped;
+
+	~Asset_File(void) {
+		if (is_mapped) { file::unmap(view); }
+	}
+};
+
 // @Todo: revisit
-static void read_file_safely(cstring path, Array<u8> & buffer) {
+static void read_file_safely(cstring path, Asset_File & asset_file) {
+	if (pack::read(path, asset_file.view, asset_file.buffer)) { return; }
+
 	constexpr u32 count = 4;
 	if (!file::get_time(path)) { CUSTOM_ASSERT(false, "file doesn't exist '%s'", path); return; }
+
+	if (file::map(path, asset_file.view)) {
+		if (asset_file.view.count % file::get_page_size()) { asset_file.is_mapped = true; return; }
+		file::unmap(asset_file.view);
+	}
+
 	for (u32 i = 0; i < count; ++i) {
-		if (file::read(path, buffer)) { return; }
+		if (!file::read(path, asset_file.buffer)) { continue; }
+		asset_file.buffer.push('\0'); --asset_file.buffer.count;
+		asset_file.view = {asset_file.buffer.data, asset_file.buffer.count};
+		return;
 	}
 	CUSTOM_ASSERT(false, "failed to read file safely: '%s'", path);
 }
 
+template<typename T>
+static void * decode_asset(cstring path) {
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return NULL; }
+
+	// @Note: zeroes stand for empty arrays
+	T * asset = (T *)calloc(1, sizeof(T));
+	asset->update(file.view);
+	return asset;
+}
+
+// @Note: moves a decoded asset into its pool slot, or discards it if the slot is gone;
+//        a missing result zeroes the slot; returns whether the asset has been filled
+template<typename T>
+static bool apply_asset(Asset & asset_ref, void * decoded) {
+	RefT<T> & refT = (RefT<T> &)asset_ref;
+	T * source = (T *)decoded;
+
+	if (!refT.exists()) {
+		if (source) { source->~T(); free(source); }
+		return false;
+	}
+
+	T * asset = refT.get_fast();
+	if (!source) { memset(asset, 0, sizeof(T)); return false; }
+
+	memcpy(asset, source, sizeof(T));
+	free(source);
+	return true;
+}
+
 }
 
 //
@@ -64,11 +119,14 @@ LOADING_FUNC(asset_pool_load_Shader_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Shader_Asset * asset = refT.get_fast();
-	asset->update(file);
+	asset->source.data     = NULL;
+	asset->source.capacity = 0;
+	asset->source.count    = 0;
+	asset->update(file.view);
 
 	// @Note: direct asset to the GVM
 	custom::loader::bc->write(graphics::Instruction::Allocate_Shader);
@@ -101,11 +159,11 @@ LOADING_FUNC(asset_pool_update_Shader_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Shader_Asset * asset = refT.get_fast();
-	asset->update(file);
+	asset->update(file.view);
 
 	// @Note: direct asset to the GVM
 	custom::loader::bc->write(graphics::Instruction::Free_Shader);
@@ -118,6 +176,21 @@ LOADING_FUNC(asset_pool_update_Shader_Asset) {
 	custom::loader::bc->write((Ref &)asset_ref);
 }
 
+DECODING_FUNC(asset_pool_decode_Shader_Asset) {
+	return decode_asset<Shader_Asset>(path);
+}
+
+APPLYING_FUNC(asset_pool_apply_Shader_Asset) {
+	if (!apply_asset<Shader_Asset>(asset_ref, decoded)) { return; }
+
+	// @Note: direct asset to the GVM
+	custom::loader::bc->write(graphics::Instruction::Allocate_Shader);
+	custom::loader::bc->write((Ref &)asset_ref);
+
+	custom::loader::bc->write(graphics::Instruction::Load_Shader);
+	custom::loader::bc->write((Ref &)asset_ref);
+}
+
 }}
 
 //
@@ -135,11 +208,11 @@ LOADING_FUNC(asset_pool_load_Texture_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Texture_Asset * asset = refT.get_fast();
-	asset->update(file);
+	asset->update(file.view);
 
 	// @Note: direct asset to the GVM
 	custom::loader::bc->write(graphics::Instruction::Allocate_Texture);
@@ -172,11 +245,11 @@ LOADING_FUNC(asset_pool_update_Texture_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Texture_Asset * asset = refT.get_fast();
-	asset->update(file);
+	asset->update(file.view);
 
 	// @Note: direct asset to the GVM
 	custom::loader::bc->write(graphics::Instruction::Free_Texture);
@@ -189,6 +262,26 @@ LOADING_FUNC(asset_pool_update_Texture_Asset) {
 	custom::loader::bc->write((Ref &)asset_ref);
 }
 
+DECODING_FUNC(asset_pool_decode_Texture_Asset) {
+	Texture_Asset * asset = (Texture_Asset *)decode_asset<Texture_Asset>(path);
+	if (asset && !asset->data.data) {
+		asset->~Texture_Asset(); free(asset);
+		return NULL;
+	}
+	return asset;
+}
+
+APPLYING_FUNC(asset_pool_apply_Texture_Asset) {
+	if (!apply_asset<Texture_Asset>(asset_ref, decoded)) { return; }
+
+	// @Note: direct asset to the GVM
+	custom::loader::bc->write(graphics::Instruction::Allocate_Texture);
+	custom::loader::bc->write((Ref &)asset_ref);
+
+	custom::loader::bc->write(graphics::Instruction::Load_Texture);
+	custom::loader::bc->write((Ref &)asset_ref);
+}
+
 }}
 
 //
@@ -206,14 +299,14 @@ LOADING_FUNC(asset_pool_load_Mesh_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Mesh_Asset * asset = refT.get_fast();
 	asset->buffers.data     = NULL;
 	asset->buffers.capacity = 0;
 	asset->buffers.count    = 0;
-	asset->update(file);
+	asset->update(file.view);
 
 	// @Note: direct asset to the GVM
 	custom::loader::bc->write(graphics::Instruction::Allocate_Mesh);
@@ -246,11 +339,11 @@ LOADING_FUNC(asset_pool_update_Mesh_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Mesh_Asset * asset = refT.get_fast();
-	asset->update(file);
+	asset->update(file.view);
 
 	// @Note: direct asset to the GVM
 	custom::loader::bc->write(graphics::Instruction::Free_Mesh);
@@ -263,6 +356,21 @@ LOADING_FUNC(asset_pool_update_Mesh_Asset) {
 	custom::loader::bc->write((Ref &)asset_ref);
 }
 
+DECODING_FUNC(asset_pool_decode_Mesh_Asset) {
+	return decode_asset<Mesh_Asset>(path);
+}
+
+APPLYING_FUNC(asset_pool_apply_Mesh_Asset) {
+	if (!apply_asset<Mesh_Asset>(asset_ref, decoded)) { return; }
+
+	// @Note: direct asset to the GVM
+	custom::loader::bc->write(graphics::Instruction::Allocate_Mesh);
+	custom::loader::bc->write((Ref &)asset_ref);
+
+	custom::loader::bc->write(graphics::Instruction::Load_Mesh);
+	custom::loader::bc->write((Ref &)asset_ref);
+}
+
 }}
 
 //
@@ -280,14 +388,14 @@ LOADING_FUNC(asset_pool_load_Collider2d_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Collider2d_Asset * asset = refT.get_fast();
 	asset->points.data     = NULL;
 	asset->points.capacity = 0;
 	asset->points.count    = 0;
-	asset->update(file);
+	asset->update(file.view);
 }
 
 LOADING_FUNC(asset_pool_unload_Collider2d_Asset) {
@@ -309,11 +417,19 @@ LOADING_FUNC(asset_pool_update_Collider2d_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Collider2d_Asset * asset = refT.get_fast();
-	asset->update(file);
+	asset->update(file.view);
+}
+
+DECODING_FUNC(asset_pool_decode_Collider2d_Asset) {
+	return decode_asset<Collider2d_Asset>(path);
+}
+
+APPLYING_FUNC(asset_pool_apply_Collider2d_Asset) {
+	apply_asset<Collider2d_Asset>(asset_ref, decoded);
 }
 
 }}
@@ -325,9 +441,7 @@ LOADING_FUNC(asset_pool_update_Collider2d_Asset) {
 namespace custom {
 namespace loading {
 
-Entity entity_read(Array<u8> & file) {
-	file.push('\0'); --file.count;
-
+Entity entity_read(file::View file) {
 	cstring source = (cstring)file.data;
 	Entity entity = Entity::create(false);
 	entity.read(&source);
@@ -352,11 +466,11 @@ LOADING_FUNC(asset_pool_load_Prefab_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Prefab_Asset * asset = refT.get_fast();
-	Entity prefab_entity = entity_read(file);
+	Entity prefab_entity = entity_read(file.view);
 
 	// @Note: memory might have been relocated
 	if (!refT.exists()) { CUSTOM_ASSERT(false, "asset doesn exist"); }
@@ -386,8 +500,8 @@ LOADING_FUNC(asset_pool_update_Prefab_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	// @Todo: update descendants, too?
 	Prefab_Asset * asset = refT.get_fast();
@@ -396,7 +510,7 @@ LOADING_FUNC(asset_pool_update_Prefab_Asset) {
 	// @Note: memory might have been relocated
 	if (!refT.exists()) { CUSTOM_ASSERT(false, "asset doesn exist"); }
 	asset = refT.get_fast();
-	Entity prefab_entity = entity_read(file);
+	Entity prefab_entity = entity_read(file.view);
 
 	// @Note: memory might have been relocated
 	if (!refT.exists()) { CUSTOM_ASSERT(false, "asset doesn exist"); }
@@ -421,14 +535,14 @@ LOADING_FUNC(asset_pool_load_Config_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Config_Asset * asset = refT.get_fast();
 	asset->entries.data     = NULL;
 	asset->entries.capacity = 0;
 	asset->entries.count    = 0;
-	asset->update(file);
+	asset->update(file.view);
 
 	// @Note: config is a passive data storage
 }
@@ -452,11 +566,11 @@ LOADING_FUNC(asset_pool_update_Config_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Config_Asset * asset = refT.get_fast();
-	asset->update(file);
+	asset->update(file.view);
 
 	// @Note: config is a passive data storage
 }
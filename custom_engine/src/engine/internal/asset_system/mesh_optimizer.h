@@ -0,0 +1,175 @@
+// https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+// https://github.com/zeux/meshoptimizer/blob/master/src/vfetchoptimizer.cpp
+
+#include <math.h>
+
+namespace custom {
+namespace mesh {
+
+// @Note: a simulated LRU cache; entries past its size are being evicted
+constexpr u32 const cache_size    = 32;
+constexpr u32 const valence_limit = 32;
+
+struct Vertex_Cache_Scores {
+	r32 cache[cache_size];
+	r32 valence[valence_limit];
+};
+
+static Vertex_Cache_Scores get_vertex_cache_scores(void) {
+	Vertex_Cache_Scores scores;
+
+	// @Note: the last triangle's vertices score the same, so that the order
+	//        it has been emitted in doesn't matter
+	for (u32 i = 0; i < cache_size; ++i) {
+		if (i < 3) { scores.cache[i] = 0.75f; continue; }
+		r32 scale = 1.0f / (r32)(cache_size - 3);
+		scores.cache[i] = powf(1.0f - (r32)(i - 3) * scale, 1.5f);
+	}
+
+	// @Note: boost vertices with few triangles left, in order to get rid of them
+	scores.valence[0] = 0;
+	for (u32 i = 1; i < valence_limit; ++i) {
+		scores.valence[i] = 2.0f / sqrtf((r32)i);
+	}
+
+	return scores;
+}
+
+inline static r32 get_vertex_score(Vertex_Cache_Scores const & scores, u32 cache_position, u32 remaining) {
+	if (!remaining) { return -1.0f; }
+	r32 score = (cache_position < cache_size) ? scores.cache[cache_position] : 0;
+	return score + scores.valence[(remaining < valence_limit) ? remaining : valence_limit - 1];
+}
+
+// @Note: greedily emits the triangle, which vertices score the most, among the ones
+//        touching the cache; falls back to the next unemitted triangle otherwise
+static void optimize_vertex_cache(Array<u32> & indices, u32 vertices_count) {
+	u32 tris_count = indices.count / 3;
+	if (tris_count < 2) { return; }
+
+	Vertex_Cache_Scores const scores = get_vertex_cache_scores();
+
+	// @Note: triangles per vertex; the first `remaining` of them are yet to be emitted
+	Array<u32> remaining(vertices_count, vertices_count);
+	Array<u32> offsets(vertices_count + 1, vertices_count + 1);
+	Array<u32> vertex_tris(indices.count, indices.count);
+	memset(remaining.data, 0, vertices_count * sizeof(u32));
+	for (u32 i = 0; i < indices.count; ++i) {
+		++remaining[indices[i]];
+	}
+	offsets[0] = 0;
+	for (u32 i = 0; i < vertices_count; ++i) {
+		offsets[i + 1] = offsets[i] + remaining[i];
+		remaining[i] = 0;
+	}
+	for (u32 i = 0; i < indices.count; ++i) {
+		u32 vertex = indices[i];
+		vertex_tris[offsets[vertex] + remaining[vertex]++] = i / 3;
+	}
+
+	Array<u32> cache_positions(vertices_count, vertices_count);
+	Array<r32> vertex_scores(vertices_count, vertices_count);
+	for (u32 i = 0; i < vertices_count; ++i) {
+		cache_positions[i] = custom::empty_index;
+		vertex_scores[i] = get_vertex_score(scores, custom::empty_index, remaining[i]);
+	}
+
+	Array<b8> tri_emitted(tris_count, tris_count);
+	memset(tri_emitted.data, 0, tris_count * sizeof(b8));
+
+	u32 best_tri = custom::empty_index;
+	r32 best_score = -1.0f;
+	for (u32 i = 0; i < tris_count; ++i) {
+		u32 const * tri = indices.data + i * 3;
+		r32 score = vertex_scores[tri[0]] + vertex_scores[tri[1]] + vertex_scores[tri[2]];
+		if (score > best_score) { best_score = score; best_tri = i; }
+	}
+
+	u32 cache[cache_size + 3];
+	u32 next_cache[cache_size + 3];
+	u32 cache_count = 0;
+
+	Array<u32> output(indices.count);
+	u32 next_unemitted = 0;
+	while (best_tri != custom::empty_index) {
+		u32 const * tri = indices.data + best_tri * 3;
+		output.push_range(tri, 3);
+		tri_emitted[best_tri] = true;
+
+		for (u32 corner = 0; corner < 3; ++corner) {
+			u32 vertex = tri[corner];
+			u32 * tris = vertex_tris.data + offsets[vertex];
+			u32 last = --remaining[vertex];
+			for (u32 i = 0; i < last; ++i) {
+				if (tris[i] != best_tri) { continue; }
+				tris[i] = tris[last];
+				break;
+			}
+		}
+
+		// @Note: the triangle goes to the front, the rest shift back
+		u32 next_cache_count = 0;
+		for (u32 corner = 0; corner < 3; ++corner) {
+			next_cache[next_cache_count++] = tri[corner];
+		}
+		for (u32 i = 0; i < cache_count; ++i) {
+			u32 vertex = cache[i];
+			if (vertex == tri[0] || vertex == tri[1] || vertex == tri[2]) { continue; }
+			next_cache[next_cache_count++] = vertex;
+		}
+
+		for (u32 i = 0; i < next_cache_count; ++i) {
+			u32 vertex = next_cache[i];
+			cache_positions[vertex] = (i < cache_size) ? i : custom::empty_index;
+			vertex_scores[vertex] = get_vertex_score(scores, cache_positions[vertex], remaining[vertex]);
+		}
+
+		best_tri = custom::empty_index;
+		best_score = -1.0f;
+		for (u32 i = 0; i < next_cache_count; ++i) {
+			u32 vertex = next_cache[i];
+			u32 const * tris = vertex_tris.data + offsets[vertex];
+			for (u32 tri_i = 0; tri_i < remaining[vertex]; ++tri_i) {
+				u32 const * adjacent = indices.data + tris[tri_i] * 3;
+				r32 score = vertex_scores[adjacent[0]] + vertex_scores[adjacent[1]] + vertex_scores[adjacent[2]];
+				if (score > best_score) { best_score = score; best_tri = tris[tri_i]; }
+			}
+		}
+
+		cache_count = (next_cache_count < cache_size) ? next_cache_count : cache_size;
+		memcpy(cache, next_cache, cache_count * sizeof(u32));
+
+		if (best_tri != custom::empty_index) { continue; }
+		while (next_unemitted < tris_count && tri_emitted[next_unemitted]) { ++next_unemitted; }
+		if (next_unemitted < tris_count) { best_tri = next_unemitted; }
+	}
+
+	memcpy(indices.data, output.data, output.count * sizeof(u32));
+}
+
+// @Note: orders vertices by their first use, so that fetches go mostly forward;
+//        drops unreferenced vertices
+static void optimize_vertex_fetch(Array<r32> & vertices, u32 elements_per_vertex, Array<u32> & indices) {
+	u32 vertices_count = vertices.count / elements_per_vertex;
+
+	Array<u32> remap(vertices_count, vertices_count);
+	memset(remap.data, 0xff, vertices_count * sizeof(u32));
+
+	Array<r32> reordered(vertices.count);
+	u32 next_vertex = 0;
+	for (u32 i = 0; i < indices.count; ++i) {
+		u32 vertex = indices[i];
+		if (remap[vertex] == custom::empty_index) {
+			remap[vertex] = next_vertex++;
+			reordered.push_range(vertices.data + vertex * elements_per_vertex, elements_per_vertex);
+		}
+		indices[i] = remap[vertex];
+	}
+
+	vertices.set_capacity(0);
+	vertices.data     = reordered.data;     reordered.data     = NULL;
+	vertices.capacity = reordered.capacity; reordered.capacity = 0;
+	vertices.count    = reordered.count;    reordered.count    = 0;
+}
+
+}}
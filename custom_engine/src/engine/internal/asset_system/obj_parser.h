@@ -34,8 +34,18 @@ static face_index parse_face_index(cstring * source) {
 	return {v, vt, vn};
 }
 
-inline static u32 translate_face_index(s32 value, u32 base) {
-	return (value > 0) ? (value - 1) : (base + value);
+// @Note: faces reference attributes either absolutely or relative to the ones read so far;
+//        a chunk doesn't know the latter, so relative indices are marked and stored as
+//        signed offsets from the chunk start, see `remap_face_index`
+constexpr u32 const local_flag = 0x80000000;
+
+inline static u32 translate_face_index(s32 value, u32 local_count) {
+	return (value > 0) ? (value - 1) : (local_flag | ((local_count + value) & ~local_flag));
+}
+
+inline static u32 remap_face_index(u32 value, u32 base) {
+	if (!(value & local_flag)) { return value; }
+	return base + (u32)((s32)(value << 1) >> 1);
 }
 
 struct tri_index { u32 v, t, n; };
@@ -59,55 +69,108 @@ static void parse_face_line(cstring source, Array<tri_index> & temporary_buffer,
 	}
 }
 
-static void parse(Array<u8> const & file, Array<u8> & vertex_attributes, Array<r32> & vertices, Array<u32> & indices) {
-	cstring source;
-
-	// @Note: prepare packed buffers
-	u32 count_buffer_v  = 0;
-	u32 count_buffer_vt = 0;
-	u32 count_buffer_vn = 0;
-	u32 count_buffer_f  = 0;
-
-	source = (cstring)file.data;
-	while (*source) {
-		switch (*source) {
-			case 'v': ++source; switch (*source) {
-				case ' ': ++count_buffer_v; break;
-				case 't': ++count_buffer_vt; break;
-				case 'n': ++count_buffer_vn; break;
-			} break;
+// @Note: a line-aligned part of the file, parsed in a single pass
+struct Chunk {
+	cstring          begin, end;
+	Array<vec3>      packed_v;
+	Array<vec2>      packed_vt;
+	Array<vec3>      packed_vn;
+	Array<tri_index> packed_tris;
+};
 
-			case 'f': ++count_buffer_f; break;
-		}
-		to_next_line(&source);
-	}
-
-	Array<vec3> packed_v(count_buffer_v);
-	Array<vec2> packed_vt(count_buffer_vt);
-	Array<vec3> packed_vn(count_buffer_vn);
-	Array<tri_index> packed_tris(count_buffer_f * 3 * 2);
+static void parse_chunk(Chunk & chunk) {
 	Array<tri_index> temporary_buffer(4);
 
-	// @Note: read packed data
-	source = (cstring)file.data;
-	while (*source) {
+	cstring source = chunk.begin;
+	while (source < chunk.end && *source) {
 		switch (*source) {
 			case 'v': ++source; switch (*source) {
-				case ' ':           packed_v.push(parse_vec3(&source)); break;
-				case 't': ++source; packed_vt.push(parse_vec2(&source)); break;
-				case 'n': ++source; packed_vn.push(parse_vec3(&source)); break;
+				case ' ':           chunk.packed_v.push(parse_vec3(&source)); break;
+				case 't': ++source; chunk.packed_vt.push(parse_vec2(&source)); break;
+				case 'n': ++source; chunk.packed_vn.push(parse_vec3(&source)); break;
 			} break;
 
 			case 'f': {
 				++source;
 				parse_face_line(
-					source, temporary_buffer, packed_tris,
-					packed_v.count, packed_vt.count, packed_vn.count
+					source, temporary_buffer, chunk.packed_tris,
+					chunk.packed_v.count, chunk.packed_vt.count, chunk.packed_vn.count
 				);
 			} break;
 		}
 		to_next_line(&source);
 	}
+}
+
+static THREAD_TASK_FUNC(parse_chunk_task) {
+	parse_chunk(((Chunk *)data)[index]);
+}
+
+inline static u32 tri_index_hash(tri_index value) {
+	return hash_jenkins(hash_jenkins(hash_jenkins(value.v) ^ value.t) ^ value.n);
+}
+
+constexpr u64 const chunk_size_min = 1 << 20;
+constexpr u32 const chunks_limit   = 16;
+
+// @Note: splits the file into `chunks_count` line-aligned parts; the result doesn't
+//        depend on their number
+static void parse_chunks(file::View file, u32 chunks_count, Array<u8> & vertex_attributes, Array<r32> & vertices, Array<u32> & indices) {
+	if (chunks_count > chunks_limit) { chunks_count = chunks_limit; }
+	if (chunks_count < 1) { chunks_count = 1; }
+
+	Chunk chunks[chunks_limit];
+	cstring const data = (cstring)file.data;
+	cstring const end  = data + file.count;
+	cstring begin = data;
+	for (u32 i = 0; i < chunks_count; ++i) {
+		cstring chunk_end = end;
+		if (i + 1 < chunks_count) {
+			chunk_end = data + file.count * (i + 1) / chunks_count;
+			if (chunk_end < begin) { chunk_end = begin; }
+			while (chunk_end < end && *chunk_end != '\n') { ++chunk_end; }
+			if (chunk_end < end) { ++chunk_end; }
+		}
+		chunks[i].begin = begin;
+		chunks[i].end   = chunk_end;
+		begin = chunk_end;
+	}
+
+	// @Note: the rest of the chunks are queued to the workers, rather than given threads
+	//        of their own; `join` helps with the ones no worker has claimed yet
+	thread::Background_Task * task = NULL;
+	if (chunks_count > 1) { task = thread::start_on_workers(&parse_chunk_task, chunks + 1, chunks_count - 1); }
+	parse_chunk(chunks[0]);
+	if (task) { thread::join(task); }
+
+	// @Note: merge chunks into the first one, remapping their indices
+	Array<vec3> & packed_v = chunks[0].packed_v;
+	Array<vec2> & packed_vt = chunks[0].packed_vt;
+	Array<vec3> & packed_vn = chunks[0].packed_vn;
+	Array<tri_index> & packed_tris = chunks[0].packed_tris;
+	u32 base_v = 0, base_vt = 0, base_vn = 0;
+	for (u32 i = 0; i < chunks_count; ++i) {
+		Chunk & chunk = chunks[i];
+		for (u32 tri_i = 0; tri_i < chunk.packed_tris.count; ++tri_i) {
+			tri_index & fi = chunk.packed_tris.data[tri_i];
+			fi.v = remap_face_index(fi.v, base_v);
+			fi.t = remap_face_index(fi.t, base_vt);
+			fi.n = remap_face_index(fi.n, base_vn);
+		}
+		base_v  += chunk.packed_v.count;
+		base_vt += chunk.packed_vt.count;
+		base_vn += chunk.packed_vn.count;
+		if (i == 0) { continue; }
+
+		packed_v.push_range(chunk.packed_v.data, chunk.packed_v.count);
+		packed_vt.push_range(chunk.packed_vt.data, chunk.packed_vt.count);
+		packed_vn.push_range(chunk.packed_vn.data, chunk.packed_vn.count);
+		packed_tris.push_range(chunk.packed_tris.data, chunk.packed_tris.count);
+		chunk.packed_v.set_capacity(0);
+		chunk.packed_vt.set_capacity(0);
+		chunk.packed_vn.set_capacity(0);
+		chunk.packed_tris.set_capacity(0);
+	}
 
 	// @Note: unpack vertices
 	#define PUSH_STRIDE_IMPL(array)                                  \
@@ -124,45 +187,58 @@ static void parse(Array<u8> const & file, Array<u8> & vertex_attributes, Array<r
 	PUSH_STRIDE_IMPL(packed_vn);
 	#undef PUSH_STRIDE_IMPL
 
-	vertices.set_capacity(count_buffer_f * 3 * elements_per_vertex);
-	indices.set_capacity(count_buffer_f * 3);
+	vertices.set_capacity(packed_tris.count * elements_per_vertex);
+	indices.set_capacity(packed_tris.count);
 
-	// u64 ticks_before = custom::timer::get_ticks();
-	Array<u32> packed_indices(packed_tris.capacity, packed_tris.capacity);
+	// @Note: deduplicate face corners with an open addressing table of the first
+	//        corners with a given `(v, t, n)`, `empty_index` is a free entry
+	u32 capacity = 16;
+	while (capacity < packed_tris.count * 2) { capacity *= 2; }
+	Array<u32> table(capacity, capacity);
+	memset(table.data, 0xff, capacity * sizeof(u32));
+	u32 mask = capacity - 1;
+
+	Array<u32> packed_indices(packed_tris.count, packed_tris.count);
 	u32 next_index = 0;
 	for (u32 i = 0; i < packed_tris.count; ++i) {
 		tri_index fi = packed_tris.data[i];
-		u32 index = custom::empty_index;
-
-		for (u32 prev = 0; prev < i; ++prev) {
-			// @Optimize
-			tri_index prev_fi = packed_tris.data[prev];
-			if (fi.v != prev_fi.v) { continue; }
-			if (fi.t != prev_fi.t) { continue; }
-			if (fi.n != prev_fi.n) { continue; }
-			fi = prev_fi;
-			index = packed_indices.data[prev];
-			break;
+
+		u32 position = tri_index_hash(fi) & mask;
+		while (table.data[position] != custom::empty_index) {
+			tri_index prev_fi = packed_tris.data[table.data[position]];
+			if (fi.v == prev_fi.v && fi.t == prev_fi.t && fi.n == prev_fi.n) { break; }
+			position = (position + 1) & mask;
 		}
 
-		if (index == custom::empty_index) {
-			index = next_index++;
-			packed_indices.data[i] = index;
+		if (table.data[position] != custom::empty_index) {
+			indices.push(packed_indices.data[table.data[position]]);
+			continue;
+		}
 
-			#define PUSH_VERTEX_IMPL(array, i)                                                   \
-			if (array.count > 0) {                                                               \
-			    vertices.push_range((r32 *)&array.data[i], (sizeof(*array.data) / sizeof(r32))); \
-			}                                                                                    \
+		u32 index = next_index++;
+		table.data[position] = i;
+		packed_indices.data[i] = index;
 
-			PUSH_VERTEX_IMPL(packed_v, fi.v);
-			PUSH_VERTEX_IMPL(packed_vt, fi.t);
-			PUSH_VERTEX_IMPL(packed_vn, fi.n);
-			#undef PUSH_VERTEX_IMPL
-		}
+		#define PUSH_VERTEX_IMPL(array, i)                                                   \
+		if (array.count > 0) {                                                               \
+		    vertices.push_range((r32 *)&array.data[i], (sizeof(*array.data) / sizeof(r32))); \
+		}                                                                                    \
+
+		PUSH_VERTEX_IMPL(packed_v, fi.v);
+		PUSH_VERTEX_IMPL(packed_vt, fi.t);
+		PUSH_VERTEX_IMPL(packed_vn, fi.n);
+		#undef PUSH_VERTEX_IMPL
 
 		indices.push(index);
 	}
-	// CUSTOM_TRACE("unpack: %lld", (custom::timer::get_ticks() - ticks_before));
+}
+
+static void parse(file::View file, Array<u8> & vertex_attributes, Array<r32> & vertices, Array<u32> & indices) {
+	// @Note: small files aren't worth splitting; `thread::run` isn't used, as meshes
+	//        are decoded by background batches, while it serves a single job at once
+	u32 chunks_count = (u32)(file.count / chunk_size_min);
+	if (chunks_count > thread::get_workers_count() + 1) { chunks_count = thread::get_workers_count() + 1; }
+	parse_chunks(file, chunks_count, vertex_attributes, vertices, indices);
 }
 
 }}
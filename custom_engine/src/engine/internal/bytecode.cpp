@@ -29,24 +29,30 @@ void Bytecode::write_bytes(u8 alignment, u8 const * data, u32 count) {
 }
 
 u8 const * Bytecode::read_bytes(u8 alignment, u32 count) const {
-	read_offset = CUSTOM_ALIGN(read_offset, alignment);
-	if (read_offset + count > buffer.count) {
+	if (!can_read_bytes(alignment, count)) {
 		CUSTOM_ASSERT(false, "reading past written instructions");
 		return NULL;
 	}
+	read_offset = CUSTOM_ALIGN(read_offset, alignment);
 	u8 const * data = buffer.data + read_offset;
 	read_offset += count;
 	return data;
 }
 
 void Bytecode::copy_bytes(u8 alignment, u8 * out, u32 count) const {
-	read_offset = CUSTOM_ALIGN(read_offset, alignment);
-	if (read_offset + count > buffer.count) {
+	if (!can_read_bytes(alignment, count)) {
 		CUSTOM_ASSERT(false, "reading past written instructions");
 		return;
 	}
+	read_offset = CUSTOM_ALIGN(read_offset, alignment);
 	memcpy(out, buffer.data + read_offset, count);
 	read_offset += count;
 }
 
+// @Note: 64 bits, so that neither the aligned offset nor the sum overflows
+bool Bytecode::can_read_bytes(u8 alignment, u64 count) const {
+	u64 offset = CUSTOM_ALIGN((u64)read_offset, alignment);
+	return offset + count <= buffer.count;
+}
+
 }
@@ -47,8 +47,31 @@ template struct Array<Ref>;
 template struct Array<ref_void_func *>;
 template struct Array<void_ref_func *>;
 template struct Array<bool_ref_func *>;
+template struct Array<void_u32_func *>;
+template struct Array<void_void_func *>;
+template struct Array<ref_ref_func *>;
+template struct Array<ptr_void_func *>;
+template struct Array<void_ptr_func *>;
+template struct Array<void *>;
+
+template struct Array<Relocation>;
+
+}
+
+// @Note: initialize compile-time structs (Array_Paged<T>)
+#if defined(REF_POOL_PAGED)
+namespace custom {
+
+template struct Array_Paged<u32>;
+
+#define COMPONENT_IMPL(T) template struct Array_Paged<T>;
+#include "engine/registry_impl/component_types.h"
+
+#define ASSET_IMPL(T) template struct Array_Paged<T>;
+#include "engine/registry_impl/asset_types.h"
 
 }
+#endif
 
 // @Note: initialize compile-time structs (Bytecode)
 namespace custom {
@@ -27,6 +27,18 @@ Transform Transform::transform(Transform const & value) const {
 	return result;
 }
 
+vec3 Transform::inverse_transform(vec3 const & value) const {
+	return quat_rotate(quat_conjugate(rotation), value - position) / scale;
+}
+
+Transform Transform::inverse_transform(Transform const & value) const {
+	Transform result;
+	result.position = inverse_transform(value.position);
+	result.scale    = value.scale / scale;
+	result.rotation = quat_product(quat_conjugate(rotation), value.rotation);
+	return result;
+}
+
 //
 // Camera
 //
@@ -39,22 +51,101 @@ mat4 Camera::to_matrix(r32 aspect) const {
 	);
 }
 
+//
+// world storage
+//
+
+// @Note: engine hooks' data is kept per world; see `custom::Entity::State::hooks`
+struct Entity_Hooks_Storage {
+	custom::Array<Hierarchy::Link> links;
+	Transform_Cache::Storage       transform_cache;
+};
+
+static Entity_Hooks_Storage & entity_hooks_get_storage(custom::Entity::State & world) {
+	// @Note: arrays are POD, zeroes stand for empty ones
+	if (!world.hooks) { world.hooks = calloc(1, sizeof(Entity_Hooks_Storage)); }
+	return *(Entity_Hooks_Storage *)world.hooks;
+}
+
+namespace custom {
+
+void entity_hooks_free_storage(Entity::State & world) {
+	if (!world.hooks) { return; }
+	Entity_Hooks_Storage * storage = (Entity_Hooks_Storage *)world.hooks;
+	storage->~Entity_Hooks_Storage();
+	free(storage); world.hooks = NULL;
+}
+
+}
+
+custom::Array<Hierarchy::Link> & Hierarchy::get_links(void) {
+	return entity_hooks_get_storage(*custom::Entity::world).links;
+}
+
+Transform_Cache::Storage & Transform_Cache::get_storage(void) {
+	return entity_hooks_get_storage(*custom::Entity::world).transform_cache;
+}
+
 //
 // Hierarchy
 //
 
 template struct custom::Array<Hierarchy::Link>;
-custom::Array<Hierarchy::Link> Hierarchy::links;
 
-void Hierarchy::fetch_children(custom::Entity const & entity, custom::Array<Hierarchy::Link> & buffer) {
-	for (u32 i = 0; i < Hierarchy::links.count; ++i) {
-		if (Hierarchy::links[i].id != entity.id) { continue; }
-		buffer.push({i, Hierarchy::links[i].entity});
+constexpr static Hierarchy::Link const empty_link = {
+	custom::empty_index, custom::empty_index, custom::empty_index, custom::empty_index, custom::empty_index
+};
+
+static void hierarchy_unlink(u32 child) {
+	custom::Array<Hierarchy::Link> & links = Hierarchy::get_links();
+	Hierarchy::Link & link = links.get(child);
+	if (link.parent == custom::empty_index) { return; }
+
+	Hierarchy::Link & parent = links.get(link.parent);
+	if (link.prev_sibling != custom::empty_index) { links.get(link.prev_sibling).next_sibling = link.next_sibling; }
+	else { parent.first_child = link.next_sibling; }
+	if (link.next_sibling != custom::empty_index) { links.get(link.next_sibling).prev_sibling = link.prev_sibling; }
+	else { parent.last_child = link.prev_sibling; }
+
+	link.parent       = custom::empty_index;
+	link.prev_sibling = custom::empty_index;
+	link.next_sibling = custom::empty_index;
+
+	Transform_Cache::mark_dirty();
+}
+
+void Hierarchy::ensure_capacity(u32 entities_count) {
+	custom::Array<Hierarchy::Link> & links = Hierarchy::get_links();
+	u32 capacity_before = links.capacity;
+	links.ensure_capacity(entities_count);
+	for (u32 i = capacity_before; i < links.capacity; ++i) {
+		links.data[i] = empty_link;
+	}
+}
+
+void Hierarchy::fetch_children(custom::Entity const & entity, custom::Array<custom::Entity> & buffer) {
+	custom::Array<Hierarchy::Link> & links = Hierarchy::get_links();
+	if (entity.id >= links.capacity) { return; }
+	u32 child = links.get(entity.id).first_child;
+	while (child != custom::empty_index) {
+		buffer.push({child, custom::Entity::world->generations.gens[child]});
+		child = links.get(child).next_sibling;
 	}
 }
 
 void Hierarchy::set_parent(custom::Entity & child, custom::Entity const & entity) {
-	Hierarchy::links.push({entity.id, child});
+	custom::Array<Hierarchy::Link> & links = Hierarchy::get_links();
+	Hierarchy::ensure_capacity((child.id > entity.id ? child.id : entity.id) + 1);
+	hierarchy_unlink(child.id);
+
+	Hierarchy::Link & link = links.get(child.id);
+	Hierarchy::Link & parent = links.get(entity.id);
+	link.parent       = entity.id;
+	link.prev_sibling = parent.last_child;
+	if (parent.last_child != custom::empty_index) { links.get(parent.last_child).next_sibling = child.id; }
+	else { parent.first_child = child.id; }
+	parent.last_child = child.id;
+	Transform_Cache::mark_dirty();
 
 	custom::RefT<Hierarchy> hierarchy_refT = child.add_component<Hierarchy>();
 	Hierarchy * hierarchy = hierarchy_refT.get_fast();
@@ -62,14 +153,185 @@ void Hierarchy::set_parent(custom::Entity & child, custom::Entity const & entity
 }
 
 void Hierarchy::rem_parent(custom::Entity & child, custom::Entity const & entity) {
-	for (u32 i = 0; i < Hierarchy::links.count; ++i) {
-		if (Hierarchy::links[i].id != entity.id) { continue; }
-		if (Hierarchy::links[i].entity != child) { continue; }
-		Hierarchy::links.remove_at(i);
-		break;
+	custom::Array<Hierarchy::Link> & links = Hierarchy::get_links();
+	if (child.id >= links.capacity) { return; }
+	if (links.get(child.id).parent != entity.id) { return; }
+	hierarchy_unlink(child.id);
+}
+
+void Hierarchy::remove(custom::Entity const & entity) {
+	custom::Array<Hierarchy::Link> & links = Hierarchy::get_links();
+	if (entity.id >= links.capacity) { return; }
+	hierarchy_unlink(entity.id);
+
+	u32 child = links.get(entity.id).first_child;
+	while (child != custom::empty_index) {
+		Hierarchy::Link & link = links.get(child);
+		child = link.next_sibling;
+		link.parent       = custom::empty_index;
+		link.prev_sibling = custom::empty_index;
+		link.next_sibling = custom::empty_index;
 	}
+	links.get(entity.id) = empty_link;
+	Transform_Cache::mark_dirty();
+}
+
+void Hierarchy::reset(void) {
+	custom::Array<Hierarchy::Link> & links = Hierarchy::get_links();
+	for (u32 i = 0; i < links.capacity; ++i) {
+		links.data[i] = empty_link;
+	}
+	Transform_Cache::mark_dirty();
+}
+
+//
+// Transform_Cache
+//
+
+static bool transform_cache_contains(u32 entity) {
+	Transform_Cache::Storage & cache = Transform_Cache::get_storage();
+	return entity < cache.slots.capacity && cache.slots.get(entity) != custom::empty_index;
+}
+
+// @Note: roots first, then breadth-first over `Hierarchy::get_links`,
+//        so that parents always precede their children
+static void transform_cache_rebuild(void) {
+	custom::Array<Hierarchy::Link> & links = Hierarchy::get_links();
+	Transform_Cache::Storage & cache = Transform_Cache::get_storage();
+	u32 const count = cache.entities.count;
+
+	custom::Array<custom::Entity> order(count);
+	custom::Array<u32> parents(count);
+	for (u32 i = 0; i < count; ++i) {
+		custom::Entity const & entity = cache.entities[i];
+		u32 parent = (entity.id < links.capacity) ? links.get(entity.id).parent : custom::empty_index;
+		if (parent != custom::empty_index && transform_cache_contains(parent)) { continue; }
+		order.push(entity);
+		parents.push(custom::empty_index);
+	}
+
+	for (u32 i = 0; i < order.count; ++i) {
+		if (order[i].id >= links.capacity) { continue; }
+		u32 child = links.get(order[i].id).first_child;
+		for (; child != custom::empty_index; child = links.get(child).next_sibling) {
+			if (!transform_cache_contains(child)) { continue; }
+			order.push({child, custom::Entity::world->generations.gens[child]});
+			parents.push(i);
+		}
+	}
+	CUSTOM_ASSERT(order.count == count, "hierarchy is corrupted");
+
+	cache.entities.count = 0; cache.entities.push_range(order.data, order.count);
+	cache.parents.count  = 0; cache.parents.push_range(parents.data, parents.count);
+
+	cache.locals.count     = 0;
+	cache.versions.count   = 0;
+	cache.transforms.count = 0;
+	cache.matrices.count   = 0;
+	cache.locals.ensure_capacity(order.count);
+	cache.versions.ensure_capacity(order.count);
+	cache.transforms.ensure_capacity(order.count);
+	cache.matrices.ensure_capacity(order.count);
+	for (u32 i = 0; i < order.count; ++i) {
+		cache.slots.get(order[i].id) = i;
+		cache.locals.push(order[i].get_component(custom::Component_Registry<Transform>::type));
+		cache.versions.push(0);
+		cache.transforms.push();
+		cache.matrices.push();
+	}
+
+	cache.is_dirty = false;
+	cache.tick     = 0;
+}
+
+void Transform_Cache::add(custom::Entity const & entity) {
+	Transform_Cache::Storage & cache = Transform_Cache::get_storage();
+	u32 capacity_before = cache.slots.capacity;
+	cache.slots.ensure_capacity(entity.id + 1);
+	for (u32 i = capacity_before; i < cache.slots.capacity; ++i) {
+		cache.slots.data[i] = custom::empty_index;
+	}
+
+	if (cache.slots.get(entity.id) != custom::empty_index) { return; }
+	cache.slots.get(entity.id) = cache.entities.count;
+	cache.entities.push(entity);
+	cache.is_dirty = true;
+}
+
+void Transform_Cache::remove(custom::Entity const & entity) {
+	Transform_Cache::Storage & cache = Transform_Cache::get_storage();
+	if (!transform_cache_contains(entity.id)) { return; }
+
+	u32 slot = cache.slots.get(entity.id);
+	cache.slots.get(entity.id) = custom::empty_index;
+	cache.entities.remove_at(slot);
+	if (slot < cache.entities.count) {
+		cache.slots.get(cache.entities[slot].id) = slot;
+	}
+	cache.is_dirty = true;
+}
+
+void Transform_Cache::mark_dirty(void) {
+	Transform_Cache::Storage & cache = Transform_Cache::get_storage();
+	cache.is_dirty = true;
+}
+
+void Transform_Cache::update(void) {
+	Transform_Cache::Storage & cache = Transform_Cache::get_storage();
+	if (cache.is_dirty) { transform_cache_rebuild(); }
+
+	custom::Ref_PoolT<Transform> & pool = custom::RefT<Transform>::get_pool();
+	u32 const tick = custom::change_tick;
+	for (u32 i = 0; i < cache.entities.count; ++i) {
+		custom::Ref const & local_ref = cache.locals[i];
+		u32 parent = cache.parents[i];
+
+		bool is_changed = pool.get_version(local_ref) >= cache.tick;
+		bool parent_is_changed = (parent != custom::empty_index) && (cache.versions[parent] == tick);
+		if (!is_changed && !parent_is_changed) { continue; }
+
+		Transform const * local = pool.get_fast(local_ref);
+		cache.transforms[i] = (parent == custom::empty_index)
+			? *local
+			: cache.transforms[parent].transform(*local);
+		cache.matrices[i] = cache.transforms[i].to_matrix();
+		cache.versions[i] = tick;
+	}
+
+	cache.tick = tick;
+}
+
+Transform const * Transform_Cache::get_transform(custom::Entity const & entity) {
+	Transform_Cache::Storage & cache = Transform_Cache::get_storage();
+	CUSTOM_ASSERT(!cache.is_dirty, "transform cache is outdated");
+	if (!transform_cache_contains(entity.id)) { return NULL; }
+	return &cache.transforms[cache.slots.get(entity.id)];
+}
+
+mat4 const * Transform_Cache::get_matrix(custom::Entity const & entity) {
+	Transform_Cache::Storage & cache = Transform_Cache::get_storage();
+	CUSTOM_ASSERT(!cache.is_dirty, "transform cache is outdated");
+	if (!transform_cache_contains(entity.id)) { return NULL; }
+	return &cache.matrices[cache.slots.get(entity.id)];
+}
+
+void Transform_Cache::set_transform(custom::Entity const & entity, Transform const & value) {
+	Transform_Cache::Storage & cache = Transform_Cache::get_storage();
+	CUSTOM_ASSERT(!cache.is_dirty, "transform cache is outdated");
+	if (!transform_cache_contains(entity.id)) { return; }
+
+	u32 slot = cache.slots.get(entity.id);
+	u32 parent = cache.parents[slot];
+
+	custom::Ref_PoolT<Transform> & pool = custom::RefT<Transform>::get_pool();
+	pool.touch(cache.locals[slot]);
+	*pool.get_fast(cache.locals[slot]) = (parent == custom::empty_index)
+		? value
+		: cache.transforms[parent].inverse_transform(value);
 }
 
-void Hierarchy::remove_at(u32 id) {
-	Hierarchy::links.remove_at(id);
+u32 Transform_Cache::get_version(custom::Entity const & entity) {
+	Transform_Cache::Storage & cache = Transform_Cache::get_storage();
+	if (!transform_cache_contains(entity.id)) { return 0; }
+	return cache.versions[cache.slots.get(entity.id)];
 }
@@ -14,14 +14,29 @@ template void custom::Entity::rem_component<T>(void);                  \
 template custom::RefT<T> custom::Entity::get_component<T>(void) const; \
 template bool custom::Entity::has_component<T>(void) const;            \
 
+#define TAG_IMPL(T)                                              \
+template custom::RefT<T> custom::Entity::add_component<T>(void); \
+template void custom::Entity::rem_component<T>(void);            \
+template bool custom::Entity::has_component<T>(void) const;      \
+
 #include "engine/registry_impl/component_types.h"
 
 namespace custom {
 
-#define COMPONENT_IMPL(T)                                                           \
-static REF_VOID_FUNC(ref_pool_create_##T) { return RefT<T>::pool.create(); }        \
-static VOID_REF_FUNC(ref_pool_destroy_##T) { RefT<T>::pool.destroy(ref); }          \
-static BOOL_REF_FUNC(ref_pool_contains_##T) { return RefT<T>::pool.contains(ref); } \
+#define COMPONENT_IMPL(T)                                                                                        \
+static REF_VOID_FUNC(ref_pool_create_##T) { return RefT<T>::get_pool().create(); }                               \
+static VOID_REF_FUNC(ref_pool_destroy_##T) { RefT<T>::get_pool().destroy(ref); }                                 \
+static BOOL_REF_FUNC(ref_pool_contains_##T) { return RefT<T>::get_pool().contains(ref); }                        \
+static VOID_U32_FUNC(ref_pool_reserve_##T) { RefT<T>::get_pool().reserve(value); }                               \
+static VOID_REF_FUNC(ref_pool_touch_##T) { RefT<T>::get_pool().touch(ref); }                                     \
+static VOID_VOID_FUNC(ref_pool_compact_##T) { RefT<T>::get_pool().compact(); }                                   \
+static REF_REF_FUNC(ref_pool_relocate_##T) { return RefT<T>::get_pool().relocate(ref); }                         \
+static SNAPSHOT_WRITE_FUNC(ref_pool_write_##T) { RefT<T>::get_pool().write(bc); }                                \
+static SNAPSHOT_READ_FUNC(ref_pool_read_##T) { return RefT<T>::get_pool().read(bc); }                            \
+static PTR_VOID_FUNC(ref_pool_new_##T) { return calloc(1, sizeof(Ref_PoolT<T>)); }                               \
+static VOID_PTR_FUNC(ref_pool_free_##T) { ((Ref_PoolT<T> *)value)->~Ref_PoolT<T>(); free(value); }               \
+static VOID_PTR_FUNC(ref_pool_bind_##T) { RefT<T>::bound_pool = (Ref_PoolT<T> *)value; }                         \
+static POOL_MERGE_FUNC(ref_pool_merge_##T) { RefT<T>::get_pool().append(*(Ref_PoolT<T> *)source, relocations); } \
 
 #include "engine/registry_impl/component_types.h"
 
@@ -43,7 +58,9 @@ static BOOL_REF_FUNC(ref_pool_contains_##T) { return RefT<T>::pool.contains(ref)
 // namespace custom {
 // namespace serialization {
 // 
-// #define COMPONENT_IMPL(T) READ_FUNC(component_pool_read_##T);
+// #define COMPONENT_IMPL(T)                      \
+// READ_FUNC(component_pool_read_##T);            \
+// SNAPSHOT_REMAP_FUNC(component_pool_remap_##T); \
 // #include "engine/registry_impl/component_types.h"
 // 
 // }}
@@ -53,24 +70,70 @@ void init_component_types(void) {
 	custom::Component_Registry<T>::type = custom::component_names.get_count(); \
 	custom::component_names.store_string(#T, custom::empty_index);             \
 
+	#define TAG_IMPL(T) COMPONENT_IMPL(T)
 	#include "engine/registry_impl/component_types.h"
+	CUSTOM_ASSERT(custom::component_names.get_count() <= 64, "entity signature is limited to 64 component types");
 
 	custom::Entity::vtable.create.set_capacity(custom::component_names.get_count());
 	custom::Entity::vtable.destroy.set_capacity(custom::component_names.get_count());
 	custom::Entity::vtable.contains.set_capacity(custom::component_names.get_count());
+	custom::Entity::vtable.reserve.set_capacity(custom::component_names.get_count());
+	custom::Entity::vtable.touch.set_capacity(custom::component_names.get_count());
+	custom::Entity::vtable.compact.set_capacity(custom::component_names.get_count());
+	custom::Entity::vtable.relocate.set_capacity(custom::component_names.get_count());
 	custom::Entity::vtable.copy.set_capacity(custom::component_names.get_count());
 	custom::Entity::vtable.load.set_capacity(custom::component_names.get_count());
 	custom::Entity::vtable.unload.set_capacity(custom::component_names.get_count());
 	custom::Entity::vtable.read.set_capacity(custom::component_names.get_count());
+	custom::Entity::vtable.snapshot_write.set_capacity(custom::component_names.get_count());
+	custom::Entity::vtable.snapshot_read.set_capacity(custom::component_names.get_count());
+	custom::Entity::vtable.snapshot_remap.set_capacity(custom::component_names.get_count());
+	custom::Entity::vtable.pool_create.set_capacity(custom::component_names.get_count());
+	custom::Entity::vtable.pool_destroy.set_capacity(custom::component_names.get_count());
+	custom::Entity::vtable.pool_bind.set_capacity(custom::component_names.get_count());
+	custom::Entity::vtable.pool_merge.set_capacity(custom::component_names.get_count());
+
+	#define COMPONENT_IMPL(T)                                                                     \
+	custom::Entity::vtable.create.push(&custom::ref_pool_create_##T);                             \
+	custom::Entity::vtable.destroy.push(&custom::ref_pool_destroy_##T);                           \
+	custom::Entity::vtable.contains.push(&custom::ref_pool_contains_##T);                         \
+	custom::Entity::vtable.reserve.push(&custom::ref_pool_reserve_##T);                           \
+	custom::Entity::vtable.touch.push(&custom::ref_pool_touch_##T);                               \
+	custom::Entity::vtable.compact.push(&custom::ref_pool_compact_##T);                           \
+	custom::Entity::vtable.relocate.push(&custom::ref_pool_relocate_##T);                         \
+	custom::Entity::vtable.copy.push(&custom::component_pool_copy_##T);                           \
+	custom::Entity::vtable.load.push(&custom::component_pool_load_##T);                           \
+	custom::Entity::vtable.unload.push(&custom::component_pool_unload_##T);                       \
+	custom::Entity::vtable.read.push(&custom::serialization::component_pool_read_##T);            \
+	custom::Entity::vtable.snapshot_write.push(&custom::ref_pool_write_##T);                      \
+	custom::Entity::vtable.snapshot_read.push(&custom::ref_pool_read_##T);                        \
+	custom::Entity::vtable.snapshot_remap.push(&custom::serialization::component_pool_remap_##T); \
+	custom::Entity::vtable.pool_create.push(&custom::ref_pool_new_##T);                           \
+	custom::Entity::vtable.pool_destroy.push(&custom::ref_pool_free_##T);                         \
+	custom::Entity::vtable.pool_bind.push(&custom::ref_pool_bind_##T);                            \
+	custom::Entity::vtable.pool_merge.push(&custom::ref_pool_merge_##T);                          \
 
-	#define COMPONENT_IMPL(T)                                                          \
-	custom::Entity::vtable.create.push(&custom::ref_pool_create_##T);                  \
-	custom::Entity::vtable.destroy.push(&custom::ref_pool_destroy_##T);                \
-	custom::Entity::vtable.contains.push(&custom::ref_pool_contains_##T);              \
-	custom::Entity::vtable.copy.push(&custom::component_pool_copy_##T);                \
-	custom::Entity::vtable.load.push(&custom::component_pool_load_##T);                \
-	custom::Entity::vtable.unload.push(&custom::component_pool_unload_##T);            \
-	custom::Entity::vtable.read.push(&custom::serialization::component_pool_read_##T); \
+	// @Note: tags occupy type slots, but have no routines
+	#define TAG_IMPL(T)                                                           \
+	custom::Entity::vtable.tags |= BIT(u64, custom::Component_Registry<T>::type); \
+	custom::Entity::vtable.create.push(NULL);                                     \
+	custom::Entity::vtable.destroy.push(NULL);                                    \
+	custom::Entity::vtable.contains.push(NULL);                                   \
+	custom::Entity::vtable.reserve.push(NULL);                                    \
+	custom::Entity::vtable.touch.push(NULL);                                      \
+	custom::Entity::vtable.compact.push(NULL);                                    \
+	custom::Entity::vtable.relocate.push(NULL);                                   \
+	custom::Entity::vtable.copy.push(NULL);                                       \
+	custom::Entity::vtable.load.push(NULL);                                       \
+	custom::Entity::vtable.unload.push(NULL);                                     \
+	custom::Entity::vtable.read.push(NULL);                                       \
+	custom::Entity::vtable.snapshot_write.push(NULL);                             \
+	custom::Entity::vtable.snapshot_read.push(NULL);                              \
+	custom::Entity::vtable.snapshot_remap.push(NULL);                             \
+	custom::Entity::vtable.pool_create.push(NULL);                                \
+	custom::Entity::vtable.pool_destroy.push(NULL);                               \
+	custom::Entity::vtable.pool_bind.push(NULL);                                  \
+	custom::Entity::vtable.pool_merge.push(NULL);                                 \
 
 	#include "engine/registry_impl/component_types.h"
 }
@@ -4,6 +4,7 @@
 #include "engine/debug/log.h"
 #include "engine/api/internal/component_types.h"
 #include "engine/impl/entity_system.h"
+#include "engine/impl/bytecode.h"
 
 //
 // Entity
@@ -13,18 +14,34 @@ namespace custom {
 
 void entity_do_after_copy(Entity const & from, Entity & to, bool force_instance) {
 	// @Todo: estimate if capacity reservation is better here
-	Array<Hierarchy::Link> children;
+	Array<Entity> children;
 	Hierarchy::fetch_children(from, children);
 
 	for (u32 i = 0; i < children.count; ++i) {
-		Entity child = children[i].entity.copy(force_instance);
+		Entity child = children[i].copy(force_instance);
 		Hierarchy::set_parent(child, to);
 	}
 }
 
+void entity_do_after_copy_many(Entity const & from, Entity const * to, u32 count, bool force_instance) {
+	Array<Entity> children;
+	Hierarchy::fetch_children(from, children);
+	if (children.count == 0) { return; }
+
+	Array<Entity> copies(count);
+	for (u32 i = 0; i < children.count; ++i) {
+		copies.count = 0;
+		children[i].copy_many(count, force_instance, copies);
+		Hierarchy::ensure_capacity(Entity::world->generations.gens.count);
+		for (u32 copy_i = 0; copy_i < count; ++copy_i) {
+			Hierarchy::set_parent(copies[copy_i], to[copy_i]);
+		}
+	}
+}
+
 void entity_do_before_destroy(Entity & entity) {
 	// @Todo: estimate if capacity reservation is better here
-	Array<Hierarchy::Link> children;
+	Array<Entity> children;
 	Hierarchy::fetch_children(entity, children);
 
 	// @Note: might be passed to `component_pool_unload_Hierarchy`,
@@ -32,19 +49,122 @@ void entity_do_before_destroy(Entity & entity) {
 	//        it's not pretty, but for this purpose unloaders
 	//        recieve a flag `only_component`, which tells, if a component
 	//        is being removed alone or as a part of entity destruction
-	for (u32 i = children.count; i > 0; --i) {
-		Hierarchy::remove_at(children[i - 1].id);
-	}
+	Hierarchy::remove(entity);
 
 	for (u32 i = 0; i < children.count; ++i) {
-		if (!children[i].entity.exists()) { continue; }
-		children[i].entity.destroy();
+		if (!children[i].exists()) { continue; }
+		children[i].destroy();
 	}
 }
 
 void entity_do_before_reset_system(void) {
 	// @Note: do not traverse hierarchy upon state reset
-	Hierarchy::links.count = 0;
+	Hierarchy::reset();
+}
+
+void entity_do_after_compact(u32 entities_count) {
+	// @Note: cached component refs are stale by now
+	Transform_Cache::mark_dirty();
+
+	Array<Hierarchy::Link> & links = Hierarchy::get_links();
+	if (links.capacity > entities_count) {
+		links.set_capacity(entities_count);
+	}
+
+	Array<u32> & slots = Transform_Cache::get_storage().slots;
+	if (slots.capacity > entities_count) {
+		slots.set_capacity(entities_count);
+	}
+}
+
+void entity_hooks_free_storage(Entity::State & world);
+void entity_do_destroy_world(Entity::State & world) {
+	entity_hooks_free_storage(world);
+}
+
+static u32 merge_link(Entity const * entities, u32 count, u32 id) {
+	return (id < count) ? entities[id].id : custom::empty_index;
+}
+
+void entity_do_after_merge(Entity::State & source, Entity const * entities, u32 count) {
+	// @Note: links of `source` are its own entity ids
+	Entity::State * previous = Entity::bind_world(&source);
+	Hierarchy::ensure_capacity(count);
+	Array<Hierarchy::Link> source_links(count, count);
+	memcpy(source_links.data, Hierarchy::get_links().data, count * sizeof(*source_links.data));
+	Entity::bind_world(previous);
+
+	Hierarchy::ensure_capacity(Entity::world->generations.gens.count);
+	Array<Hierarchy::Link> & links = Hierarchy::get_links();
+	for (u32 i = 0; i < count; ++i) {
+		if (!entities[i].exists()) { continue; }
+		Hierarchy::Link const & from = source_links[i];
+		Hierarchy::Link & to = links.get(entities[i].id);
+		to.parent       = merge_link(entities, count, from.parent);
+		to.first_child  = merge_link(entities, count, from.first_child);
+		to.last_child   = merge_link(entities, count, from.last_child);
+		to.prev_sibling = merge_link(entities, count, from.prev_sibling);
+		to.next_sibling = merge_link(entities, count, from.next_sibling);
+	}
+
+	// @Note: component loaders were called in `source`, so register transforms here
+	u32 const hierarchy_type = Component_Registry<Hierarchy>::type;
+	u32 const transform_type = Component_Registry<Transform>::type;
+	for (u32 i = 0; i < count; ++i) {
+		if (!entities[i].exists()) { continue; }
+		u64 signature = entities[i].get_signature();
+		if (get_bit_at_index(signature, (u8)hierarchy_type)) {
+			Hierarchy * hierarchy = entities[i].get_component<Hierarchy>().get_fast();
+			u32 parent = hierarchy->parent.id;
+			hierarchy->parent = (parent < count) ? entities[parent] : Entity{custom::empty_ref};
+		}
+		if (get_bit_at_index(signature, (u8)transform_type)) {
+			Transform_Cache::add(entities[i]);
+		}
+	}
+	Transform_Cache::mark_dirty();
+}
+
+void entity_do_write_snapshot(Bytecode & bc) {
+	u32 count = Entity::world->generations.gens.count;
+	Hierarchy::ensure_capacity(count);
+	bc.write(count);
+	bc.write(Hierarchy::get_links().data, count);
+}
+
+static bool is_valid_link(u32 value, u32 count) {
+	return value == custom::empty_index || value < count;
+}
+
+bool entity_do_after_read_snapshot(Bytecode const & bc) {
+	// @Note: links are indexed by entity ids, so they are checked for the whole world
+	u32 const entities_count = Entity::world->generations.gens.count;
+	if (!bc.can_read<u32>()) { return false; }
+	u32 count = *bc.read<u32>();
+	if (count != entities_count || !bc.can_read<Hierarchy::Link>(count)) { return false; }
+
+	Hierarchy::Link const * links = bc.read<Hierarchy::Link>(count);
+	for (u32 i = 0; i < count; ++i) {
+		Hierarchy::Link const & link = links[i];
+		bool is_valid = is_valid_link(link.parent, count)
+		             && is_valid_link(link.first_child, count)
+		             && is_valid_link(link.last_child, count)
+		             && is_valid_link(link.prev_sibling, count)
+		             && is_valid_link(link.next_sibling, count);
+		if (!is_valid) { return false; }
+	}
+
+	Hierarchy::reset();
+	Hierarchy::ensure_capacity(count);
+	memcpy(Hierarchy::get_links().data, links, count * sizeof(Hierarchy::Link));
+
+	// @Note: component loaders weren't called, so register transforms here
+	u32 const transform_type = Component_Registry<Transform>::type;
+	for (u32 id = 0; id < Entity::world->generations.gens.count; ++id) {
+		if (!get_bit_at_index(Entity::world->signatures.get(id), (u8)transform_type)) { continue; }
+		Transform_Cache::add({id, Entity::world->generations.gens[id]});
+	}
+	return true;
 }
 
 }
@@ -69,11 +189,15 @@ ENTITY_LOADING_FUNC(component_pool_load_Transform) {
 	component->position = {0, 0, 0};
 	component->scale    = {1, 1, 1};
 	component->rotation = {0, 0, 0, 1};
+
+	Transform_Cache::add(entity);
 }
 
 ENTITY_LOADING_FUNC(component_pool_unload_Transform) {
 	// RefT<Transform> & refT = (RefT<Transform> &)ref;
 	// Transform * component = refT.get_fast();
+
+	Transform_Cache::remove(entity);
 }
 
 }
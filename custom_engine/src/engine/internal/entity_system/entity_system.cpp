@@ -3,18 +3,32 @@
 #include "engine/api/internal/parsing.h"
 #include "engine/api/internal/entity_system.h"
 #include "engine/api/internal/names_lookup.h"
+#include "engine/api/internal/asset_system.h"
 #include "engine/impl/array.h"
+#include "engine/impl/bytecode.h"
 #include "engine/impl/parsing.h"
+#include "engine/impl/math_scalar.h"
+#include "engine/impl/math_bitwise.h"
+#include "engine/impl/entity_system.h"
 
 namespace custom {
 
 //  @Note: initialize compile-time structs:
 template struct Array<Entity>;
+template struct Array<Entity::Command>;
+#if defined(ENTITY_COMPONENTS_ARCHETYPE)
+template struct Array<Entity::Archetype>;
+#endif
+#if defined(ENTITY_COMPONENTS_DENSE)
+template struct Array<Entity::Component_Set>;
+#endif
 
 //  @Note: initialize compile-time statics:
 Entity::State   Entity::state;
 Entity::VTable  Entity::vtable;
+thread_local Entity::State * Entity::world = &Entity::state;
 Strings_Storage Entity::strings;
+thread_local Strings_Storage * Entity::staging_strings = NULL;
 
 }
 
@@ -24,16 +38,21 @@ Strings_Storage Entity::strings;
 
 namespace custom {
 
+// @Note: a staging thread doesn't touch the shared storage at all
+inline static Strings_Storage & get_strings(void) {
+	return Entity::staging_strings ? *Entity::staging_strings : Entity::strings;
+}
+
 u32 Entity::store_string(cstring data, u32 length) {
-	return Entity::strings.store_string(data, length);
+	return get_strings().store_string(data, length);
 }
 
 u32 Entity::get_id(cstring data, u32 length) {
-	return Entity::strings.get_id(data, length);
+	return get_strings().get_id(data, length);
 }
 
 cstring Entity::get_string(u32 id) {
-	return Entity::strings.get_string(id);
+	return get_strings().get_string(id);
 }
 
 }
@@ -48,8 +67,14 @@ namespace custom {
 //        current use only consists of managing Hierarchy components,
 //        which is too specific, surely
 void entity_do_after_copy(Entity const & from, Entity & to, bool force_instance);
+void entity_do_after_copy_many(Entity const & from, Entity const * to, u32 count, bool force_instance);
 void entity_do_before_destroy(Entity & entity);
 void entity_do_before_reset_system(void);
+void entity_do_destroy_world(Entity::State & world);
+void entity_do_after_merge(Entity::State & source, Entity const * entities, u32 count);
+void entity_do_after_compact(u32 entities_count);
+void entity_do_write_snapshot(Bytecode & bc);
+bool entity_do_after_read_snapshot(Bytecode const & bc);
 
 }
 
@@ -63,25 +88,216 @@ void read_Child_block(Entity & entity, cstring * source);
 
 namespace custom {
 
-static u32 find_instance(u32 entity) {
-	for (u32 i = 0; i < Entity::state.instances.count; ++i) {
-		if (Entity::state.instances[i].id != entity) { continue; }
-		return i;
+#if defined(ENTITY_COMPONENTS_ARCHETYPE)
+static void archetype_migrate(u32 entity, u64 signature);
+#endif
+
+#if defined(ENTITY_COMPONENTS_DENSE)
+static void component_set_remove(u32 type, u32 entity);
+#endif
+
+static void entity_components_reserve(u32 entities_count, u32 components_count);
+static void entity_components_reset(u32 entities_count);
+static void entity_components_attach(u32 entity, u32 type, Ref const & ref);
+static void entity_components_compact(u32 entities_count);
+static void entity_components_free(void);
+
+template<typename T>
+static void array_shrink(Array<T> & array, u32 capacity) {
+	if (array.capacity > capacity) { array.set_capacity(capacity); }
+}
+
+static void instances_add(Entity const & entity) {
+	Entity::world->instance_slots.get(entity.id) = Entity::world->instances.count;
+	Entity::world->instances.push(entity);
+}
+
+static void instances_remove(Entity const & entity) {
+	u32 slot = Entity::world->instance_slots.get(entity.id);
+	if (slot == custom::empty_index) { return; }
+
+	Entity::world->instance_slots.get(entity.id) = custom::empty_index;
+	Entity::world->instances.remove_at(slot);
+	if (slot < Entity::world->instances.count) {
+		Entity::world->instance_slots.get(Entity::world->instances[slot].id) = slot;
+	}
+}
+
+// @Note: tags have neither pools, nor storage slots
+static void tag_add(Entity const & entity, u32 type) {
+	Entity::world->signatures.get(entity.id) |= BIT(u64, type);
+}
+
+static void tag_rem(Entity const & entity, u32 type) {
+	if (!get_bit_at_index(entity.get_signature(), (u8)type)) { CUSTOM_ASSERT(false, "component doesn't exist"); return; }
+	Entity::world->signatures.get(entity.id) = bits_to_zero(entity.get_signature(), BIT(u64, type));
+}
+
+Entity::State * Entity::create_world(void) {
+	// @Note: arrays are POD, zeroes stand for empty ones
+	State * world = (State *)calloc(1, sizeof(State));
+	world->pools.set_capacity(Entity::vtable.pool_create.count);
+	for (u32 type = 0; type < Entity::vtable.pool_create.count; ++type) {
+		world->pools.push(Entity::is_tag(type) ? NULL : (*Entity::vtable.pool_create[type])());
+	}
+	return world;
+}
+
+void Entity::destroy_world(State * world) {
+	if (world == &Entity::state) { CUSTOM_ASSERT(false, "default world can't be destroyed"); return; }
+	if (world == Entity::world) { CUSTOM_ASSERT(false, "world is bound"); return; }
+
+	// @Note: entities are destroyed in their own world, so that hooks and
+	//        unloaders see consistent state
+	State * previous = Entity::bind_world(world);
+	Entity::reset_system();
+	entity_components_free();
+	Entity::bind_world(previous);
+
+	entity_do_destroy_world(*world);
+	for (u32 type = 0; type < world->pools.count; ++type) {
+		if (!world->pools[type]) { continue; }
+		(*Entity::vtable.pool_destroy[type])(world->pools[type]);
+	}
+	world->~State();
+	free(world);
+}
+
+Entity::State * Entity::bind_world(State * world) {
+	if (!world) { world = &Entity::state; }
+
+	State * previous = Entity::world;
+	Entity::world = world;
+	for (u32 type = 0; type < Entity::vtable.pool_bind.count; ++type) {
+		if (Entity::is_tag(type)) { continue; }
+		(*Entity::vtable.pool_bind[type])((type < world->pools.count) ? world->pools[type] : NULL);
+	}
+	return previous;
+}
+
+void Entity::merge_world(State * source, Snapshot_Remap const * remap, Array<Entity> & out) {
+	if (source == &Entity::state) { CUSTOM_ASSERT(false, "default world can't be merged"); return; }
+	if (source == Entity::world) { CUSTOM_ASSERT(false, "world is bound"); return; }
+	CUSTOM_ASSERT(!source->commands.count, "apply deferred commands first");
+
+	u32 const types_count  = Entity::vtable.pool_merge.count;
+	u32 const source_count = source->generations.gens.count;
+
+	Array<u8> is_gap(source_count, source_count);
+	memset(is_gap.data, 0, source_count * sizeof(*is_gap.data));
+	for (u32 i = 0; i < source->generations.gaps.count; ++i) {
+		is_gap[source->generations.gaps[i]] = 1;
+	}
+
+	// @Note: collect component refs per type, grouped by type
+	Array<u32> type_offsets(types_count + 1);
+	Array<u32> entity_ids;
+	Array<Ref> component_refs;
+	State * previous = Entity::bind_world(source);
+	for (u32 type = 0; type < types_count; ++type) {
+		type_offsets.push(entity_ids.count);
+		if (Entity::is_tag(type)) { continue; }
+		for (u32 id = 0; id < source_count; ++id) {
+			if (is_gap[id]) { continue; }
+			if (!get_bit_at_index(source->signatures.get(id), (u8)type)) { continue; }
+			Entity entity = {id, source->generations.gens[id]};
+			entity_ids.push(id);
+			component_refs.push(entity.get_component(type));
+		}
+	}
+	type_offsets.push(entity_ids.count);
+	Entity::bind_world(previous);
+
+	// entities
+	// @Note: reserve storages once instead of growing them per entity
+	u32 const live           = source_count - source->generations.gaps.count;
+	u32 const entities_count = Entity::world->generations.gens.count + live;
+	Entity::world->generations.ensure_capacity(entities_count);
+	Entity::world->signatures.ensure_capacity(entities_count);
+	Entity::world->instance_slots.ensure_capacity(entities_count);
+	Entity::world->instances.ensure_capacity(Entity::world->instances.count + source->instances.count);
+	entity_components_reserve(entities_count, entity_ids.count);
+
+	u32 const first = out.count;
+	out.ensure_capacity(first + source_count);
+	for (u32 id = 0; id < source_count; ++id) {
+		if (is_gap[id]) { out.push({custom::empty_ref}); continue; }
+		out.push(create(false));
+		Entity::world->signatures.get(out[out.count - 1].id) = source->signatures.get(id);
+	}
+	for (u32 i = 0; i < source->instances.count; ++i) {
+		instances_add(out[first + source->instances[i].id]);
+	}
+
+	// components
+	Array<Relocation> relocations;
+	for (u32 type = 0; type < types_count; ++type) {
+		if (Entity::is_tag(type)) { continue; }
+		(*Entity::vtable.pool_merge[type])(source->pools[type], relocations);
+		for (u32 i = type_offsets[type]; i < type_offsets[type + 1]; ++i) {
+			Relocation const & relocation = relocations[component_refs[i].id];
+			CUSTOM_ASSERT(relocation.gen == component_refs[i].gen, "component ref is corrupted");
+			component_refs[i] = relocation.ref;
+			entity_components_attach(out[first + entity_ids[i]].id, type, component_refs[i]);
+		}
+	}
+
+	entity_do_after_merge(*source, out.data + first, source_count);
+
+	// @Note: the world is consistent by now; remapping might load assets
+	if (remap) {
+		for (u32 type = 0; type < types_count; ++type) {
+			for (u32 i = type_offsets[type]; i < type_offsets[type + 1]; ++i) {
+				(*Entity::vtable.snapshot_remap[type])(component_refs[i], *remap);
+			}
+		}
 	}
-	return custom::empty_index;
+
+	// @Note: pools of `source` are empty, so are its instances
+	source->instances.count = 0;
+	Entity::destroy_world(source);
 }
 
 void Entity::reset_system(void) {
 	entity_do_before_reset_system();
-	while (Entity::state.instances.count > 0) {
-		Entity::state.instances[0].destroy();
+	Entity::world->commands.count = 0;
+	// @Note: destroying from the end avoids swapping instances around
+	while (Entity::world->instances.count > 0) {
+		Entity::world->instances[Entity::world->instances.count - 1].destroy();
 	}
-	CUSTOM_ASSERT(!Entity::state.instances.count, "still some entities");
+	CUSTOM_ASSERT(!Entity::world->instances.count, "still some entities");
+}
+
+void Entity::compact(void) {
+	CUSTOM_ASSERT(!Entity::world->commands.count, "apply deferred commands first");
+
+	for (u32 type = 0; type < Entity::vtable.compact.count; ++type) {
+		if (Entity::is_tag(type)) { continue; }
+		(*Entity::vtable.compact[type])();
+	}
+
+	// @Note: entities aren't relocated, so sparse storages can shrink
+	//        only down to the last active entity
+	u32 const entities_count = Entity::world->generations.gens.count;
+	entity_components_compact(entities_count);
+	array_shrink(Entity::world->signatures, entities_count);
+	array_shrink(Entity::world->instance_slots, entities_count);
+	array_shrink(Entity::world->instances, Entity::world->instances.count);
+	array_shrink(Entity::world->commands, 0);
+
+	entity_do_after_compact(entities_count);
 }
 
 Entity Entity::create(bool is_instance) {
-	Entity entity = {Entity::state.generations.create()};
-	if (is_instance) { Entity::state.instances.push(entity); }
+	Entity entity = {Entity::world->generations.create()};
+
+	Entity::world->signatures.ensure_capacity(entity.id + 1);
+	Entity::world->signatures.get(entity.id) = 0;
+
+	Entity::world->instance_slots.ensure_capacity(entity.id + 1);
+	Entity::world->instance_slots.get(entity.id) = custom::empty_index;
+	if (is_instance) { instances_add(entity); }
+
 	return entity;
 }
 
@@ -120,6 +336,11 @@ void Entity::read(cstring * source) {
 			to_next_line(source); continue;
 		}
 
+		if (Entity::is_tag(type)) {
+			add_component(type);
+			to_next_line(source); continue;
+		}
+
 		// @Note: component readers are assumed to early out upon discovery of
 		//        any unrecognized non-whitespace sequence
 		Ref component_ref = has_component(type) ? get_component(type) : add_component(type);
@@ -128,44 +349,70 @@ void Entity::read(cstring * source) {
 }
 
 void Entity::override_with(Entity const & source) {
-	for (u32 type = 0; type < Entity::vtable.contains.count; ++type) {
-		Ref const from_component_ref = source.get_component(type);
-		if (!(*Entity::vtable.contains[type])(from_component_ref)) {
-			if (has_component(type)) { rem_component(type); }
+	u64 from_signature = source.get_signature();
+	for (u64 bits = from_signature | get_signature(); bits; bits &= bits - 1) {
+		u32 type = get_lowest_bit_index(bits);
+		if (!get_bit_at_index(from_signature, (u8)type)) {
+			rem_component(type);
 			continue;
 		}
 
+		if (Entity::is_tag(type)) {
+			add_component(type);
+			continue;
+		}
+
+		Ref const from_component_ref = source.get_component(type);
 		Ref to_component_ref = has_component(type) ? get_component(type) : add_component(type);
 		(*Entity::vtable.copy[type])(*this, from_component_ref, to_component_ref);
+		(*Entity::vtable.touch[type])(to_component_ref);
 	}
 }
 
 void Entity::destroy(void) {
 	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return; }
 
-	u32 entity_offset = id * Entity::vtable.destroy.count;
-	if (entity_offset < Entity::state.components.capacity) {
-		for (u32 type = 0; type < Entity::vtable.destroy.count; ++type) {
-			Ref component_ref = Entity::state.components.get(entity_offset + type);
-			if ((*Entity::vtable.contains[type])(component_ref)) {
-				(*Entity::vtable.unload[type])(*this, component_ref, false);
-				(*Entity::vtable.destroy[type])(component_ref);
-			}
-		}
+	for (u64 bits = bits_to_zero(get_signature(), Entity::vtable.tags); bits; bits &= bits - 1) {
+		u32 type = get_lowest_bit_index(bits);
+		Ref component_ref = get_component(type);
+		(*Entity::vtable.unload[type])(*this, component_ref, false);
+		(*Entity::vtable.destroy[type])(component_ref);
+		#if defined(ENTITY_COMPONENTS_DENSE)
+		component_set_remove(type, id);
+		#endif
 	}
 
+	#if defined(ENTITY_COMPONENTS_ARCHETYPE)
+	archetype_migrate(id, 0);
+	#endif
+	Entity::world->signatures.get(id) = 0;
+
 	entity_do_before_destroy(*this);
-	Entity::state.generations.destroy(*this);
+	Entity::world->generations.destroy(*this);
 
-	for (u32 i = 0; i < Entity::state.instances.count; ++i) {
-		if (Entity::state.instances[i] != *this) { continue; }
-		Entity::state.instances.remove_at(i);
-		break;
-	}
+	instances_remove(*this);
+}
+
+u64 Entity::get_signature(void) const {
+	return Entity::world->signatures.get(id);
+}
+
+bool Entity::is_tag(u32 type) {
+	return get_bit_at_index(Entity::vtable.tags, (u8)type);
 }
 
 bool Entity::is_instance() const {
-	return find_instance(id) != custom::empty_index;
+	return Entity::world->instance_slots.get(id) != custom::empty_index;
+}
+
+static void entity_copy_components(Entity const & from, Entity & to) {
+	Entity::world->signatures.get(to.id) |= from.get_signature() & Entity::vtable.tags;
+	for (u64 bits = bits_to_zero(from.get_signature(), Entity::vtable.tags); bits; bits &= bits - 1) {
+		u32 type = get_lowest_bit_index(bits);
+		Ref const from_component_ref = from.get_component(type);
+		Ref to_component_ref = to.add_component(type);
+		(*Entity::vtable.copy[type])(to, from_component_ref, to_component_ref);
+	}
 }
 
 Entity Entity::copy(bool force_instance) const {
@@ -174,23 +421,56 @@ Entity Entity::copy(bool force_instance) const {
 	force_instance = force_instance || is_instance();
 	Entity entity = create(force_instance);
 
-	for (u32 type = 0; type < Entity::vtable.contains.count; ++type) {
-		Ref const from_component_ref = get_component(type);
-		if ((*Entity::vtable.contains[type])(from_component_ref)) {
-			Ref to_component_ref = entity.add_component(type);
-			(*Entity::vtable.copy[type])(entity, from_component_ref, to_component_ref);
-		}
-	}
+	entity_copy_components(*this, entity);
 
 	custom::entity_do_after_copy(*this, entity, force_instance);
 
 	return entity;
 }
 
+void Entity::copy_many(u32 count, bool force_instance, Array<Entity> & out) const {
+	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return; }
+	if (count == 0) { return; }
+
+	force_instance = force_instance || is_instance();
+	u64 const tags      = get_signature() & Entity::vtable.tags;
+	u64 const signature = bits_to_zero(get_signature(), Entity::vtable.tags);
+
+	// @Note: reserve storages once instead of growing them per copy
+	u32 const entities_count = Entity::world->generations.gens.count + count;
+	Entity::world->generations.ensure_capacity(entities_count);
+	Entity::world->signatures.ensure_capacity(entities_count);
+	Entity::world->instance_slots.ensure_capacity(entities_count);
+	if (force_instance) { Entity::world->instances.ensure_capacity(Entity::world->instances.count + count); }
+	entity_components_reserve(entities_count, count * count_bits(signature));
+	for (u64 bits = signature; bits; bits &= bits - 1) {
+		(*Entity::vtable.reserve[get_lowest_bit_index(bits)])(count);
+	}
+
+	u32 const first = out.count;
+	out.ensure_capacity(first + count);
+	for (u32 i = 0; i < count; ++i) {
+		out.push(create(force_instance));
+		Entity::world->signatures.get(out[out.count - 1].id) = tags;
+	}
+
+	// @Note: iterate per type, so that each pool is touched in one go
+	for (u64 bits = signature; bits; bits &= bits - 1) {
+		u32 type = get_lowest_bit_index(bits);
+		Ref const from_component_ref = get_component(type);
+		for (u32 i = first; i < out.count; ++i) {
+			Ref to_component_ref = out[i].add_component(type);
+			(*Entity::vtable.copy[type])(out[i], from_component_ref, to_component_ref);
+		}
+	}
+
+	custom::entity_do_after_copy_many(*this, out.data + first, count, force_instance);
+}
+
 void Entity::promote_to_instance(void) {
 	// @Todo: apply this to the whole hierarchy correctly
 	if (is_instance()) { CUSTOM_ASSERT(false, "prefab is an instance already"); return; }
-	Entity::state.instances.push(*this);
+	instances_add(*this);
 }
 
 }
@@ -203,55 +483,129 @@ void Entity::promote_to_instance(void) {
 
 namespace custom {
 
-static u32 find(u32 type, u32 entity) {
-	for (u32 i = 0; i < Entity::state.component_types.count; ++i) {
-		if (Entity::state.component_types[i] != type) { continue; }
-		if (Entity::state.component_entity_ids[i] == entity) { return i; }
+typedef Entity::Component_Set Component_Set;
+
+static Component_Set & component_set_get(u32 type) {
+	while (Entity::world->component_sets.count <= type) {
+		// @Note: array is POD and doesn't call elements' constructor
+		Entity::world->component_sets.push();
+		Component_Set & set = Entity::world->component_sets[Entity::world->component_sets.count - 1];
+		memset(&set, 0, sizeof(set));
 	}
-	return custom::empty_index;
+	return Entity::world->component_sets[type];
 }
 
-Ref Entity::add_component(u32 type) {
-	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return custom::empty_ref; }
+static void component_set_ensure_capacity(Component_Set & set, u32 entities_count) {
+	u32 capacity_before = set.slots.capacity;
+	set.slots.ensure_capacity(entities_count);
+	for (u32 i = capacity_before; i < set.slots.capacity; ++i) {
+		set.slots.data[i] = custom::empty_index;
+	}
+}
 
-	Ref component_ref = custom::empty_ref;
+static void entity_components_reserve(u32 entities_count, u32 components_count) {
+	// @Note: types are unknown here; sets in use grow their sparse part,
+	//        dense parts keep growing on demand
+	for (u32 type = 0; type < Entity::world->component_sets.count; ++type) {
+		Component_Set & set = Entity::world->component_sets[type];
+		if (set.entity_ids.count) { component_set_ensure_capacity(set, entities_count); }
+	}
+}
 
-	u32 component_index = find(type, id);
-	if (component_index != custom::empty_index) { component_ref = Entity::state.components[component_index]; }
+static void entity_components_reset(u32 entities_count) {
+	// @Note: destroyed entities leave no entries behind
+	entity_components_reserve(entities_count, 0);
+}
+
+static void entity_components_attach(u32 entity, u32 type, Ref const & ref) {
+	Component_Set & set = component_set_get(type);
+	component_set_ensure_capacity(set, entity + 1);
+	set.slots.get(entity) = set.entity_ids.count;
+	set.entity_ids.push(entity);
+	set.components.push(ref);
+}
 
-	if (component_ref.id == custom::empty_ref.id || !(*Entity::vtable.contains[type])(component_ref)) {
-		if (component_index != custom::empty_index) {
-			Entity::state.components.remove_at(component_index);
-			Entity::state.component_entity_ids.remove_at(component_index);
-			Entity::state.component_types.remove_at(component_index);
+static void entity_components_compact(u32 entities_count) {
+	for (u32 type = 0; type < Entity::world->component_sets.count; ++type) {
+		Component_Set & set = Entity::world->component_sets[type];
+		for (u32 i = 0; i < set.components.count; ++i) {
+			set.components[i] = (*Entity::vtable.relocate[type])(set.components[i]);
 		}
+		array_shrink(set.slots, entities_count);
+		array_shrink(set.entity_ids, set.entity_ids.count);
+		array_shrink(set.components, set.components.count);
+	}
+}
 
-		component_ref= (*Entity::vtable.create[type])();
-		Entity::state.components.push(component_ref);
-		Entity::state.component_entity_ids.push(id);
-		Entity::state.component_types.push(type);
+static void entity_components_free(void) {
+	// @Note: array is POD and doesn't call elements' destructor
+	for (u32 type = 0; type < Entity::world->component_sets.count; ++type) {
+		(Entity::world->component_sets.data + type)->~Component_Set();
+	}
+}
 
-		(*Entity::vtable.load[type])(*this, component_ref, true);
+static u32 find(u32 type, u32 entity) {
+	if (type >= Entity::world->component_sets.count) { return custom::empty_index; }
+	Component_Set const & set = Entity::world->component_sets[type];
+	if (entity >= set.slots.capacity) { return custom::empty_index; }
+	return set.slots.get(entity);
+}
+
+static void component_set_remove(u32 type, u32 entity) {
+	u32 slot = find(type, entity);
+	if (slot == custom::empty_index) { return; }
+
+	Component_Set & set = Entity::world->component_sets[type];
+	set.slots.get(entity) = custom::empty_index;
+	set.entity_ids.remove_at(slot);
+	set.components.remove_at(slot);
+	if (slot < set.entity_ids.count) {
+		set.slots.get(set.entity_ids[slot]) = slot;
 	}
-	// @Todo: check explicitly?
-	//else { CUSTOM_ASSERT(false, "component already exists"); }
+}
+
+Ref Entity::add_component(u32 type) {
+	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return custom::empty_ref; }
+	if (Entity::is_tag(type)) { tag_add(*this, type); return custom::empty_ref; }
+
+	Component_Set & set = component_set_get(type);
+	component_set_ensure_capacity(set, id + 1);
+
+	u32 slot = set.slots.get(id);
+	if (slot != custom::empty_index && (*Entity::vtable.contains[type])(set.components[slot])) {
+		// @Todo: check explicitly?
+		//        CUSTOM_ASSERT(false, "component already exists");
+		return set.components[slot];
+	}
+
+	Ref component_ref = (*Entity::vtable.create[type])();
+	if (slot == custom::empty_index) {
+		set.slots.get(id) = set.entity_ids.count;
+		set.entity_ids.push(id);
+		set.components.push(component_ref);
+	}
+	else { set.components[slot] = component_ref; }
+	Entity::world->signatures.get(id) |= BIT(u64, type);
+
+	(*Entity::vtable.load[type])(*this, component_ref, true);
 
 	return component_ref;
 }
 
 void Entity::rem_component(u32 type) {
+	if (Entity::is_tag(type)) { tag_rem(*this, type); return; }
+
 	// @Note: duplicates `Component::destroy` code
 	Ref component_ref = custom::empty_ref;
 
-	u32 component_index = find(type, id);
-	if (component_index != custom::empty_index) {
-		component_ref = Entity::state.components[component_index];
-		Entity::state.components.remove_at(component_index);
-		Entity::state.component_entity_ids.remove_at(component_index);
-		Entity::state.component_types.remove_at(component_index);
+	u32 slot = find(type, id);
+	if (slot != custom::empty_index) {
+		component_ref = Entity::world->component_sets[type].components[slot];
+		component_set_remove(type, id);
 	}
 
 	if ((*Entity::vtable.contains[type])(component_ref)) {
+		Entity::world->signatures.get(id) = bits_to_zero(get_signature(), BIT(u64, type));
 		(*Entity::vtable.unload[type])(*this, component_ref, true);
 		(*Entity::vtable.destroy[type])(component_ref);
 	}
@@ -261,20 +615,209 @@ void Entity::rem_component(u32 type) {
 Ref Entity::get_component(u32 type) const {
 	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return custom::empty_ref; }
 
-	u32 component_index = find(type, id);
-	if (component_index == custom::empty_index) { return custom::empty_ref; }
+	u32 slot = find(type, id);
+	if (slot == custom::empty_index) { return custom::empty_ref; }
 
-	return Entity::state.components[component_index];
+	return Entity::world->component_sets[type].components[slot];
 }
 
 bool Entity::has_component(u32 type) const {
 	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return false; }
 
-	u32 component_index = find(type, id);
-	if (component_index == custom::empty_index) { return false; }
+	return get_bit_at_index(get_signature(), (u8)type);
+}
+
+}
+
+#elif defined(ENTITY_COMPONENTS_ARCHETYPE)
 
-	Ref component_ref = Entity::state.components[component_index];
-	return (*Entity::vtable.contains[type])(component_ref);
+namespace custom {
+
+typedef Entity::Archetype Archetype;
+
+static void archetype_ids_ensure_capacity(u32 entity) {
+	u32 capacity_before = Entity::world->archetype_ids.capacity;
+	Entity::world->archetype_ids.ensure_capacity(entity + 1);
+	Entity::world->archetype_rows.ensure_capacity(Entity::world->archetype_ids.capacity);
+	for (u32 i = capacity_before; i < Entity::world->archetype_ids.capacity; ++i) {
+		Entity::world->archetype_ids.data[i] = custom::empty_index;
+		Entity::world->archetype_rows.data[i] = custom::empty_index;
+	}
+}
+
+static void entity_components_reserve(u32 entities_count, u32 components_count) {
+	// @Note: chunks are allocated per archetype upon migration
+	if (entities_count) { archetype_ids_ensure_capacity(entities_count - 1); }
+}
+
+static void entity_components_reset(u32 entities_count) {
+	// @Note: destroyed entities leave no rows behind
+	entity_components_reserve(entities_count, 0);
+}
+
+static Ref * archetype_find_ref(u32 entity, u32 type);
+static void entity_components_attach(u32 entity, u32 type, Ref const & ref) {
+	// @Note: signatures are restored beforehand, so an entity migrates only once
+	archetype_migrate(entity, Entity::world->signatures.get(entity));
+	*archetype_find_ref(entity, type) = ref;
+}
+
+static void entity_components_compact(u32 entities_count) {
+	for (u32 archetype_i = 0; archetype_i < Entity::world->archetypes.count; ++archetype_i) {
+		Archetype & archetype = Entity::world->archetypes[archetype_i];
+		u32 column = 0;
+		for (u64 bits = archetype.signature; bits; bits &= bits - 1, ++column) {
+			u32 type = get_lowest_bit_index(bits);
+			for (u32 row = 0; row < archetype.entity_ids.count; ++row) {
+				Ref & ref = archetype.get(row, column);
+				ref = (*Entity::vtable.relocate[type])(ref);
+			}
+		}
+		array_shrink(archetype.entity_ids, archetype.entity_ids.count);
+		array_shrink(archetype.components, archetype.components.count);
+	}
+	array_shrink(Entity::world->archetype_ids, entities_count);
+	array_shrink(Entity::world->archetype_rows, entities_count);
+}
+
+static void entity_components_free(void) {
+	// @Note: array is POD and doesn't call elements' destructor
+	for (u32 archetype_i = 0; archetype_i < Entity::world->archetypes.count; ++archetype_i) {
+		(Entity::world->archetypes.data + archetype_i)->~Archetype();
+	}
+}
+
+static Ref * archetype_find_ref(u32 entity, u32 type) {
+	if (entity >= Entity::world->archetype_ids.capacity) { return NULL; }
+	u32 archetype_index = Entity::world->archetype_ids.get(entity);
+	if (archetype_index == custom::empty_index) { return NULL; }
+
+	Archetype & archetype = Entity::world->archetypes[archetype_index];
+	if (!get_bit_at_index(archetype.signature, (u8)type)) { return NULL; }
+
+	u32 row = Entity::world->archetype_rows.get(entity);
+	return &archetype.get(row, archetype.get_column_index(type));
+}
+
+static u32 archetype_find_or_add(u64 signature) {
+	// @Note: archetypes are few, compared to entities
+	for (u32 i = 0; i < Entity::world->archetypes.count; ++i) {
+		if (Entity::world->archetypes[i].signature == signature) { return i; }
+	}
+
+	// @Note: array is POD and doesn't call elements' constructor
+	Entity::world->archetypes.push();
+	Archetype & archetype = Entity::world->archetypes[Entity::world->archetypes.count - 1];
+	memset(&archetype, 0, sizeof(archetype));
+	archetype.signature = signature;
+	archetype.columns   = count_bits(signature);
+	return Entity::world->archetypes.count - 1;
+}
+
+static void archetype_remove_row(u32 archetype_index, u32 row) {
+	Archetype & archetype = Entity::world->archetypes[archetype_index];
+
+	u32 last_row = archetype.entity_ids.count - 1;
+	if (row != last_row) {
+		for (u32 column = 0; column < archetype.columns; ++column) {
+			archetype.get(row, column) = archetype.get(last_row, column);
+		}
+		Entity::world->archetype_rows.get(archetype.entity_ids[last_row]) = row;
+	}
+	archetype.entity_ids.remove_at(row);
+
+	if (archetype.entity_ids.count % Archetype::chunk_rows == 0) {
+		archetype.components.count -= archetype.columns * Archetype::chunk_rows;
+	}
+}
+
+static void archetype_migrate(u32 entity, u64 signature) {
+	archetype_ids_ensure_capacity(entity);
+	signature = bits_to_zero(signature, Entity::vtable.tags);
+
+	u32 from_index = Entity::world->archetype_ids.get(entity);
+	u32 from_row   = Entity::world->archetype_rows.get(entity);
+	u64 from_signature = (from_index != custom::empty_index) ? Entity::world->archetypes[from_index].signature : 0;
+	if (from_signature == signature) { return; }
+
+	u32 to_index = custom::empty_index;
+	u32 to_row   = custom::empty_index;
+	if (signature) {
+		to_index = archetype_find_or_add(signature);
+
+		Archetype & to = Entity::world->archetypes[to_index];
+		to_row = to.entity_ids.count;
+		if (to_row % Archetype::chunk_rows == 0) {
+			to.components.push_range(to.columns * Archetype::chunk_rows);
+		}
+		to.entity_ids.push(entity);
+
+		for (u32 type = 0; type < Entity::vtable.create.count; ++type) {
+			if (!get_bit_at_index(signature, (u8)type)) { continue; }
+			Ref & to_ref = to.get(to_row, to.get_column_index(type));
+			if (get_bit_at_index(from_signature, (u8)type)) {
+				Archetype & from = Entity::world->archetypes[from_index];
+				to_ref = from.get(from_row, from.get_column_index(type));
+			}
+			else { to_ref = custom::empty_ref; }
+		}
+	}
+
+	if (from_index != custom::empty_index) {
+		archetype_remove_row(from_index, from_row);
+	}
+
+	Entity::world->archetype_ids.get(entity)  = to_index;
+	Entity::world->archetype_rows.get(entity) = to_row;
+}
+
+Ref Entity::add_component(u32 type) {
+	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return custom::empty_ref; }
+	if (Entity::is_tag(type)) { tag_add(*this, type); return custom::empty_ref; }
+
+	Ref * component_ref_ptr = archetype_find_ref(id, type);
+	if (component_ref_ptr) { return *component_ref_ptr; }
+	// @Todo: check explicitly?
+	// else { CUSTOM_ASSERT(false, "component already exists"); }
+
+	Ref component_ref = (*Entity::vtable.create[type])();
+	Entity::world->signatures.get(id) |= BIT(u64, type);
+	archetype_migrate(id, get_signature());
+	*archetype_find_ref(id, type) = component_ref;
+
+	(*Entity::vtable.load[type])(*this, component_ref, true);
+
+	return component_ref;
+}
+
+void Entity::rem_component(u32 type) {
+	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return; }
+	if (Entity::is_tag(type)) { tag_rem(*this, type); return; }
+
+	Ref * component_ref_ptr = archetype_find_ref(id, type);
+	if (!component_ref_ptr) { CUSTOM_ASSERT(false, "component doesn't exist"); return; }
+
+	Ref component_ref = *component_ref_ptr;
+	Entity::world->signatures.get(id) = bits_to_zero(get_signature(), BIT(u64, type));
+	(*Entity::vtable.unload[type])(*this, component_ref, true);
+	(*Entity::vtable.destroy[type])(component_ref);
+
+	archetype_migrate(id, get_signature());
+}
+
+Ref Entity::get_component(u32 type) const {
+	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return custom::empty_ref; }
+
+	Ref const * component_ref_ptr = archetype_find_ref(id, type);
+	if (!component_ref_ptr) { return custom::empty_ref; }
+
+	return *component_ref_ptr;
+}
+
+bool Entity::has_component(u32 type) const {
+	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return false; }
+
+	return get_bit_at_index(get_signature(), (u8)type);
 }
 
 }
@@ -283,22 +826,59 @@ bool Entity::has_component(u32 type) const {
 
 namespace custom {
 
+static void entity_components_reserve(u32 entities_count, u32 components_count) {
+	// @Note: the table is sparse and doesn't depend on `components_count`
+	u32 capacity_before = Entity::world->components.capacity;
+	Entity::world->components.ensure_capacity(entities_count * Entity::vtable.create.count);
+	for (u32 i = capacity_before; i < Entity::world->components.capacity; ++i) {
+		Entity::world->components.data[i] = custom::empty_ref;
+	}
+}
+
+static void entity_components_reset(u32 entities_count) {
+	// @Note: destroyed entities leave stale refs, which might become valid again
+	entity_components_reserve(entities_count, 0);
+	for (u32 i = 0; i < Entity::world->components.capacity; ++i) {
+		Entity::world->components.data[i] = custom::empty_ref;
+	}
+}
+
+static void entity_components_attach(u32 entity, u32 type, Ref const & ref) {
+	Entity::world->components.get(entity * Entity::vtable.create.count + type) = ref;
+}
+
+static void entity_components_compact(u32 entities_count) {
+	u32 const types_count = Entity::vtable.create.count;
+	u32 const capacity = min(entities_count * types_count, Entity::world->components.capacity);
+	array_shrink(Entity::world->components, capacity);
+
+	// @Note: stale refs are dropped on the way
+	for (u32 i = 0; i < Entity::world->components.capacity; ++i) {
+		u32 type = i % types_count;
+		Ref & ref = Entity::world->components.data[i];
+		ref = (!Entity::is_tag(type) && get_bit_at_index(Entity::world->signatures.get(i / types_count), (u8)type))
+			? (*Entity::vtable.relocate[type])(ref)
+			: custom::empty_ref;
+	}
+}
+
+static void entity_components_free(void) {
+	// @Note: the table holds refs only
+}
+
 Ref Entity::add_component(u32 type) {
 	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return custom::empty_ref; }
+	if (Entity::is_tag(type)) { tag_add(*this, type); return custom::empty_ref; }
 
-	// entity_components_ensure_capacity
-	u32 capacity_before = Entity::state.components.capacity;
-	Entity::state.components.ensure_capacity((id + 1) * Entity::vtable.create.count);
-	for (u32 i = capacity_before; i < Entity::state.components.capacity; ++i) {
-		Entity::state.components.data[i] = custom::empty_ref;
-	}
+	entity_components_reserve(id + 1, 0);
 
 	u32 component_index = id * Entity::vtable.create.count + type;
-	Ref component_ref = Entity::state.components.get(component_index);
+	Ref component_ref = Entity::world->components.get(component_index);
 
 	if (!(*Entity::vtable.contains[type])(component_ref)) {
 		component_ref = (*Entity::vtable.create[type])();
-		Entity::state.components.get(component_index) = component_ref;
+		Entity::world->components.get(component_index) = component_ref;
+		Entity::world->signatures.get(id) |= BIT(u64, type);
 
 		(*Entity::vtable.load[type])(*this, component_ref, true);
 	}
@@ -310,15 +890,17 @@ Ref Entity::add_component(u32 type) {
 
 void Entity::rem_component(u32 type) {
 	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return; }
+	if (Entity::is_tag(type)) { tag_rem(*this, type); return; }
 
 	u32 component_index = id * Entity::vtable.destroy.count + type;
-	if (component_index >= Entity::state.components.capacity) {
+	if (component_index >= Entity::world->components.capacity) {
 		CUSTOM_ASSERT(false, "component doesn't exist"); return;
 	}
 
-	Ref component_ref = Entity::state.components.get(component_index);
+	Ref component_ref = Entity::world->components.get(component_index);
 
 	if ((*Entity::vtable.contains[type])(component_ref)) {
+		Entity::world->signatures.get(id) = bits_to_zero(get_signature(), BIT(u64, type));
 		(*Entity::vtable.unload[type])(*this, component_ref, true);
 		(*Entity::vtable.destroy[type])(component_ref);
 	}
@@ -329,19 +911,15 @@ Ref Entity::get_component(u32 type) const {
 	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return custom::empty_ref; }
 
 	u32 component_index = id * Entity::vtable.contains.count + type;
-	if (component_index >= Entity::state.components.capacity) { return custom::empty_ref; }
+	if (component_index >= Entity::world->components.capacity) { return custom::empty_ref; }
 
-	return Entity::state.components.get(component_index);
+	return Entity::world->components.get(component_index);
 }
 
 bool Entity::has_component(u32 type) const {
 	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return false; }
 
-	u32 component_index = id * Entity::vtable.contains.count + type;
-	if (component_index >= Entity::state.components.capacity) { return false; }
-
-	Ref component_ref = Entity::state.components.get(component_index);
-	return (*Entity::vtable.contains[type])(component_ref);
+	return get_bit_at_index(get_signature(), (u8)type);
 }
 
 }
@@ -369,22 +947,358 @@ void Component::destroy(void) {
 	// @Note: duplicates `Entity::rem_component` code
 	CUSTOM_ASSERT(entity.get_component(type) == ref, "component ref is corrupted");
 	if ((*Entity::vtable.contains[type])(ref)) {
+		Entity::world->signatures.get(entity.id) = bits_to_zero(entity.get_signature(), BIT(u64, type));
 		(*Entity::vtable.unload[type])(entity, ref, true);
 		(*Entity::vtable.destroy[type])(ref);
 	}
 	else { CUSTOM_ASSERT(false, "component doesn't exist"); }
 
+	#if defined(ENTITY_COMPONENTS_ARCHETYPE)
+	archetype_migrate(entity.id, entity.get_signature());
+	#endif
+
 	#if defined(ENTITY_COMPONENTS_DENSE)
-	for (u32 i = 0; i < Entity::state.components.count; ++i) {
-		if (Entity::state.component_types[i] != type) { continue; }
-		if (Entity::state.component_entity_ids[i] != entity.id) { continue; }
-		if (Entity::state.components[i] != ref) { continue; }
-		Entity::state.components.remove_at(i);
-		Entity::state.component_entity_ids.remove_at(i);
-		Entity::state.component_types.remove_at(i);
-		break;
-	}
+	component_set_remove(type, entity.id);
 	#endif
 }
 
 }
+
+//
+// deferred commands
+//
+
+namespace custom {
+
+static void entity_record_command(Entity::Command::Action action, Ref const & entity, u32 type) {
+	Entity::world->commands.push({});
+	Entity::Command & command = Entity::world->commands[Entity::world->commands.count - 1];
+	command.action      = action;
+	command.is_instance = false;
+	command.type        = type;
+	command.entity      = entity;
+	command.source      = custom::empty_ref;
+}
+
+Entity Entity::create_deferred(bool is_instance) {
+	Entity entity = create(false);
+	entity_record_command(Command::Action::Create, entity, custom::empty_index);
+	Entity::world->commands[Entity::world->commands.count - 1].is_instance = is_instance;
+	return entity;
+}
+
+Entity Entity::copy_deferred(bool force_instance) const {
+	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return {custom::empty_ref}; }
+
+	Entity entity = create(false);
+	entity_record_command(Command::Action::Copy, entity, custom::empty_index);
+	Entity::world->commands[Entity::world->commands.count - 1].is_instance = force_instance || is_instance();
+	Entity::world->commands[Entity::world->commands.count - 1].source = *this;
+	return entity;
+}
+
+void Entity::destroy_deferred(void) {
+	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return; }
+	entity_record_command(Command::Action::Destroy, *this, custom::empty_index);
+}
+
+void Entity::add_component_deferred(u32 type) {
+	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return; }
+	entity_record_command(Command::Action::Add, *this, type);
+}
+
+void Entity::rem_component_deferred(u32 type) {
+	if (!exists()) { CUSTOM_ASSERT(false, "entity doesn't exist"); return; }
+	entity_record_command(Command::Action::Rem, *this, type);
+}
+
+void Entity::apply_commands(void) {
+	// @Note: applying might record new commands, e.g. via `entity_do_after_copy`;
+	//        those are processed as a consecutive batch
+	while (Entity::world->commands.count > 0) {
+		Array<Command> commands;
+		commands.data     = Entity::world->commands.data;     Entity::world->commands.data     = NULL;
+		commands.capacity = Entity::world->commands.capacity; Entity::world->commands.capacity = 0;
+		commands.count    = Entity::world->commands.count;    Entity::world->commands.count    = 0;
+
+		// @Note: commands apply in the recording order, as they depend on each other,
+		//        e.g. `rem` then `add` of the same type, or `copy` of a prefab after
+		//        `add`s to it; instead of reordering, storages are pre-sized once
+		u32 types_count = Entity::vtable.reserve.count;
+		u32 add_counts[64] = {};
+		u32 entities_count = 0;
+		for (u32 i = 0; i < commands.count; ++i) {
+			Command const & command = commands[i];
+			entities_count = max(entities_count, command.entity.id + 1);
+			if (command.action == Command::Action::Add) { ++add_counts[command.type]; }
+			if (command.action == Command::Action::Copy) {
+				Entity source = {command.source};
+				if (!source.exists()) { continue; }
+				for (u64 bits = source.get_signature(); bits; bits &= bits - 1) {
+					++add_counts[get_lowest_bit_index(bits)];
+				}
+			}
+		}
+
+		u32 components_count = 0;
+		for (u32 type = 0; type < types_count; ++type) {
+			if (!add_counts[type] || Entity::is_tag(type)) { continue; }
+			components_count += add_counts[type];
+			(*Entity::vtable.reserve[type])(add_counts[type]);
+		}
+		entity_components_reserve(entities_count, components_count);
+
+		for (u32 i = 0; i < commands.count; ++i) {
+			Command const & command = commands[i];
+			Entity entity = {command.entity};
+			// @Note: an entity might have been destroyed in between
+			if (!entity.exists()) { continue; }
+
+			switch (command.action) {
+				case Command::Action::Create: {
+					if (command.is_instance && !entity.is_instance()) { instances_add(entity); }
+				} break;
+
+				case Command::Action::Copy: {
+					Entity source = {command.source};
+					if (!source.exists()) { CUSTOM_ASSERT(false, "prefab doesn't exist"); continue; }
+					entity_copy_components(source, entity);
+					if (command.is_instance && !entity.is_instance()) { instances_add(entity); }
+					custom::entity_do_after_copy(source, entity, command.is_instance);
+				} break;
+
+				case Command::Action::Add: {
+					if (!entity.has_component(command.type)) { entity.add_component(command.type); }
+				} break;
+
+				case Command::Action::Rem: {
+					if (entity.has_component(command.type)) { entity.rem_component(command.type); }
+				} break;
+
+				case Command::Action::Destroy: {
+					entity.destroy();
+				} break;
+			}
+		}
+	}
+}
+
+}
+
+//
+// snapshot
+//
+
+namespace custom {
+
+// @Note: bump the version upon any change of the layout below
+constexpr static u32 const snapshot_magic   = 0x4E534543; // "CESN"
+constexpr static u32 const snapshot_version = 3;
+
+struct Snapshot_Strings {
+	cstring values;
+	u32 const * offsets;
+	u32 const * lengths;
+	u32 count;
+};
+
+static void snapshot_write_strings(Bytecode & bc, Strings_Storage const & strings) {
+	bc.write(strings.values.count);
+	bc.write(strings.values.data, strings.values.count);
+	bc.write(strings.offsets.count);
+	bc.write(strings.offsets.data, strings.offsets.count);
+	bc.write(strings.lengths.data, strings.lengths.count);
+}
+
+static bool snapshot_read_strings(Bytecode const & bc, Snapshot_Strings & strings) {
+	if (!bc.can_read<u32>()) { return false; }
+	u32 values_count = *bc.read<u32>();
+	if (!bc.can_read<char>(values_count)) { return false; }
+	strings.values = bc.read<char>(values_count);
+
+	if (!bc.can_read<u32>()) { return false; }
+	strings.count = *bc.read<u32>();
+	if (!bc.can_read<u32>(strings.count)) { return false; }
+	strings.offsets = bc.read<u32>(strings.count);
+	if (!bc.can_read<u32>(strings.count)) { return false; }
+	strings.lengths = bc.read<u32>(strings.count);
+
+	for (u32 i = 0; i < strings.count; ++i) {
+		if ((u64)strings.offsets[i] + strings.lengths[i] > values_count) { return false; }
+	}
+	return true;
+}
+
+static void snapshot_remap_strings(Snapshot_Strings const & source, Strings_Storage & strings, Array<u32> & remap) {
+	remap.ensure_capacity(source.count);
+	for (u32 i = 0; i < source.count; ++i) {
+		remap.push(strings.store_string(source.values + source.offsets[i], source.lengths[i]));
+	}
+}
+
+void Entity::write_snapshot(Bytecode & bc) {
+	CUSTOM_ASSERT(!Entity::world->commands.count, "apply deferred commands first");
+
+	bc.write(snapshot_magic);
+	bc.write(snapshot_version);
+
+	// @Note: component types are validated by name
+	snapshot_write_strings(bc, custom::component_names);
+	bc.write(Entity::vtable.tags);
+	snapshot_write_strings(bc, Entity::strings);
+	snapshot_write_strings(bc, Asset::strings);
+
+	// entities
+	u32 const entities_count = Entity::world->generations.gens.count;
+	Entity::world->generations.write(bc);
+	bc.write(Entity::world->signatures.data, entities_count);
+	bc.write(Entity::world->instances.count);
+	bc.write(Entity::world->instances.data, Entity::world->instances.count);
+
+	// components
+	Array<u32> entity_ids;
+	Array<Ref> component_refs;
+	for (u32 type = 0; type < Entity::vtable.snapshot_write.count; ++type) {
+		// @Note: tags are fully described by signatures
+		if (Entity::is_tag(type)) { continue; }
+		entity_ids.count = 0;
+		component_refs.count = 0;
+		for (u32 id = 0; id < entities_count; ++id) {
+			if (!get_bit_at_index(Entity::world->signatures.get(id), (u8)type)) { continue; }
+			Entity entity = {id, Entity::world->generations.gens[id]};
+			entity_ids.push(id);
+			component_refs.push(entity.get_component(type));
+		}
+
+		bc.write(entity_ids.count);
+		bc.write(entity_ids.data, entity_ids.count);
+		bc.write(component_refs.data, component_refs.count);
+		(*Entity::vtable.snapshot_write[type])(bc);
+	}
+
+	entity_do_write_snapshot(bc);
+}
+
+// @Note: every count is checked against the remaining bytes before it's used,
+//        and every id against the storage it indexes
+#define SNAPSHOT_CHECK(statement) if (!(statement)) { CUSTOM_ASSERT(false, "snapshot is corrupted"); return false; }
+
+bool Entity::read_snapshot(Bytecode const & bc) {
+	if (!Entity::world->generations.is_empty()) { CUSTOM_ASSERT(false, "world isn't empty"); return false; }
+
+	SNAPSHOT_CHECK(bc.can_read<u32>(2));
+	if (*bc.read<u32>() != snapshot_magic)   { CUSTOM_ASSERT(false, "not a snapshot"); return false; }
+	if (*bc.read<u32>() != snapshot_version) { CUSTOM_ASSERT(false, "snapshot version mismatch"); return false; }
+
+	Snapshot_Strings types;
+	SNAPSHOT_CHECK(snapshot_read_strings(bc, types));
+	bool types_match = (types.count == custom::component_names.get_count());
+	for (u32 i = 0; types_match && i < types.count; ++i) {
+		types_match = (custom::component_names.get_id(types.values + types.offsets[i], types.lengths[i]) == i);
+	}
+	SNAPSHOT_CHECK(bc.can_read<u64>());
+	types_match = types_match && (*bc.read<u64>() == Entity::vtable.tags);
+	if (!types_match) { CUSTOM_ASSERT(false, "snapshot component types mismatch"); return false; }
+
+	Snapshot_Strings entity_strings, asset_strings;
+	SNAPSHOT_CHECK(snapshot_read_strings(bc, entity_strings));
+	SNAPSHOT_CHECK(snapshot_read_strings(bc, asset_strings));
+
+	Snapshot_Remap remap;
+	snapshot_remap_strings(entity_strings, Entity::strings, remap.entity_strings);
+	snapshot_remap_strings(asset_strings, Asset::strings, remap.asset_strings);
+
+	// entities
+	SNAPSHOT_CHECK(Entity::world->generations.read(bc));
+	u32 const entities_count = Entity::world->generations.gens.count;
+
+	// @Note: signatures are zeroed until components are validated, so that
+	//        a failed read leaves no components behind to be destroyed
+	Entity::world->signatures.ensure_capacity(entities_count);
+	memset(Entity::world->signatures.data, 0, entities_count * sizeof(u64));
+	SNAPSHOT_CHECK(bc.can_read<u64>(entities_count));
+	Array<u64> signatures(entities_count, entities_count);
+	bc.copy(signatures.data, entities_count);
+
+	SNAPSHOT_CHECK(bc.can_read<u32>());
+	u32 instances_count = *bc.read<u32>();
+	SNAPSHOT_CHECK(bc.can_read<Entity>(instances_count));
+	Entity const * instances = bc.read<Entity>(instances_count);
+
+	// components
+	entity_components_reset(entities_count);
+
+	// @Note: each signature should be matched by the attached components exactly,
+	//        otherwise destroying its entity would touch stale refs
+	Array<u64> attached(entities_count, entities_count);
+	memset(attached.data, 0, entities_count * sizeof(u64));
+
+	Array<u32> remap_entities;
+	Array<u32> remap_types;
+	Array<Ref> remap_refs;
+	for (u32 type = 0; type < Entity::vtable.snapshot_read.count; ++type) {
+		if (Entity::is_tag(type)) { continue; }
+		SNAPSHOT_CHECK(bc.can_read<u32>());
+		u32 count = *bc.read<u32>();
+		SNAPSHOT_CHECK(bc.can_read<u32>(count));
+		u32 const * entity_ids     = bc.read<u32>(count);
+		SNAPSHOT_CHECK(bc.can_read<Ref>(count));
+		Ref const * component_refs = bc.read<Ref>(count);
+		SNAPSHOT_CHECK((*Entity::vtable.snapshot_read[type])(bc));
+
+		for (u32 i = 0; i < count; ++i) {
+			u32 const entity = entity_ids[i];
+			SNAPSHOT_CHECK(entity < entities_count);
+			SNAPSHOT_CHECK(get_bit_at_index(signatures[entity], (u8)type));
+			SNAPSHOT_CHECK(!get_bit_at_index(attached[entity], (u8)type));
+			SNAPSHOT_CHECK((*Entity::vtable.contains[type])(component_refs[i]));
+			attached[entity] |= BIT(u64, type);
+			remap_entities.push(entity);
+			remap_types.push(type);
+			remap_refs.push(component_refs[i]);
+		}
+	}
+	for (u32 id = 0; id < entities_count; ++id) {
+		SNAPSHOT_CHECK(attached[id] == bits_to_zero(signatures[id], Entity::vtable.tags));
+	}
+
+	// @Note: components are attached only once all of them are validated;
+	//        the hierarchy is validated by its hook before it's read
+	memcpy(Entity::world->signatures.data, signatures.data, entities_count * sizeof(u64));
+	for (u32 i = 0; i < remap_refs.count; ++i) {
+		entity_components_attach(remap_entities[i], remap_types[i], remap_refs[i]);
+	}
+
+	SNAPSHOT_CHECK(entity_do_after_read_snapshot(bc));
+
+	// @Note: instances go last, as those are what `reset_system` destroys
+	Entity::world->instance_slots.ensure_capacity(entities_count);
+	for (u32 i = 0; i < entities_count; ++i) {
+		Entity::world->instance_slots.get(i) = custom::empty_index;
+	}
+	bool instances_are_valid = true;
+	for (u32 i = 0; instances_are_valid && i < instances_count; ++i) {
+		Entity const & instance = instances[i];
+		instances_are_valid = instance.exists() && (Entity::world->instance_slots.get(instance.id) == custom::empty_index);
+		if (instances_are_valid) { Entity::world->instance_slots.get(instance.id) = i; }
+	}
+	if (!instances_are_valid) {
+		for (u32 i = 0; i < entities_count; ++i) {
+			Entity::world->instance_slots.get(i) = custom::empty_index;
+		}
+	}
+	SNAPSHOT_CHECK(instances_are_valid);
+	Entity::world->instances.count = 0;
+	Entity::world->instances.push_range(instances, instances_count);
+
+	// @Note: the world is consistent by now; remapping might load assets
+	for (u32 i = 0; i < remap_refs.count; ++i) {
+		(*Entity::vtable.snapshot_remap[remap_types[i]])(remap_refs[i], remap);
+	}
+
+	return true;
+}
+
+#undef SNAPSHOT_CHECK
+
+}
@@ -5,6 +5,7 @@
 #include "engine/api/internal/parsing.h"
 #include "engine/api/internal/component_types.h"
 #include "engine/api/internal/asset_types.h"
+#include "engine/api/internal/scene_streaming.h"
 #include "engine/impl/entity_system.h"
 #include "engine/impl/asset_system.h"
 #include "engine/impl/math_linear.h"
@@ -17,6 +18,18 @@
 namespace custom {
 namespace serialization {
 
+static Entity read_prefab(cstring * source) {
+	u32 path_length = to_string_length(source);
+	u32 path_id     = Asset::store_string(*source, path_length);
+
+	// @Note: a staging thread doesn't touch the asset system
+	if (streaming::is_staging()) { return streaming::get_prefab(path_id); }
+
+	Asset_RefT<Prefab_Asset> prefab_asset_ref = Asset::add<Prefab_Asset>(path_id);
+	Prefab_Asset * prefab_asset = prefab_asset_ref.ref.get_fast();
+	return prefab_asset->entity;
+}
+
 void read_Entity_block(Entity & entity, cstring * source) {
 	bool done = false;
 
@@ -26,7 +39,7 @@ void read_Entity_block(Entity & entity, cstring * source) {
 		switch ((parse_void(source), **source)) {
 			case 'i': ++(*source); {
 				bool is_instance = (bool)(parse_void(source), parse_u32(source));
-				if (is_instance) { entity.promote_to_instance(); }
+				if (is_instance && !entity.is_instance()) { entity.promote_to_instance(); }
 			} break;
 
 			case 'o': ++(*source); {
@@ -34,13 +47,7 @@ void read_Entity_block(Entity & entity, cstring * source) {
 			} break;
 
 			case 'p': ++(*source); {
-				u32 path_length = to_string_length(source);
-				u32 path_id     = Asset::store_string(*source, path_length);
-				Asset_RefT<Prefab_Asset> prefab_asset_ref = Asset::add<Prefab_Asset>(path_id);
-
-				Prefab_Asset * prefab_asset = prefab_asset_ref.ref.get_fast();
-				Entity source_entity = prefab_asset->entity;
-
+				Entity source_entity = read_prefab(source);
 				entity.override_with(source_entity);
 			} break;
 
@@ -69,12 +76,7 @@ void read_Child_block(Entity & entity, cstring * source) {
 			} break;
 
 			case 'p': ++(*source); {
-				u32 path_length = to_string_length(source);
-				u32 path_id     = Asset::store_string(*source, path_length);
-				Asset_RefT<Prefab_Asset> prefab_asset_ref = Asset::add<Prefab_Asset>(path_id);
-
-				Prefab_Asset * prefab_asset = prefab_asset_ref.ref.get_fast();
-				Entity child = prefab_asset->entity.copy(is_instance);
+				Entity child = read_prefab(source).copy(is_instance);
 
 				Hierarchy::set_parent(child, entity);
 				last_child = child;
@@ -133,6 +135,11 @@ READ_FUNC(component_pool_read_Transform) {
 	}
 }
 
+SNAPSHOT_REMAP_FUNC(component_pool_remap_Transform) {
+	// RefT<Transform> & refT = (RefT<Transform> &)ref;
+	// Transform * component = refT.get_fast();
+}
+
 }}
 
 //
@@ -176,6 +183,11 @@ READ_FUNC(component_pool_read_Camera) {
 	}
 }
 
+SNAPSHOT_REMAP_FUNC(component_pool_remap_Camera) {
+	// RefT<Camera> & refT = (RefT<Camera> &)ref;
+	// Camera * component = refT.get_fast();
+}
+
 }}
 
 //
@@ -195,4 +207,8 @@ READ_FUNC(component_pool_read_Hierarchy) {
 	CUSTOM_ASSERT(false, "is not implemented");
 }
 
+SNAPSHOT_REMAP_FUNC(component_pool_remap_Hierarchy) {
+	/*entity generations are restored as is, so is the parent reference*/
+}
+
 }}
@@ -75,9 +75,11 @@ static int Asset_add(lua_State * L) {
 	u32 id = Asset::store_string(id_string, custom::empty_index);
 	Asset asset = Asset::add(type, id);
 	
+	// @Note: userdata holds the asset until being collected; see `__gc` of the asset types
 	Asset * udata = (Asset *)lua_newuserdatauv(L, sizeof(Asset), 0);
 	luaL_setmetatable(L, custom::asset_names.get_string(type));
 	*udata = asset;
+	asset.acquire();
 
 	return 1;
 }
@@ -121,9 +123,11 @@ static int Asset_get(lua_State * L) {
 	bool has_asset = (*Asset::vtable.contains[type])(asset);
 	if (!has_asset) { lua_pushnil(L); return 1; }
 
+	// @Note: userdata holds the asset until being collected; see `__gc` of the asset types
 	Asset * udata = (Asset *)lua_newuserdatauv(L, sizeof(Asset), 0);
 	luaL_setmetatable(L, custom::asset_names.get_string(type));
 	*udata = asset;
+	asset.acquire();
 
 	return 1;
 }
@@ -68,10 +68,20 @@ static int Shader_Asset_eq(lua_State * L) {
 	return 1;
 }
 
+static int Shader_Asset_gc(lua_State * L) {
+	typedef custom::Asset_RefT<custom::Shader_Asset> Asset_Ref;
+
+	Asset_Ref const * object = (Asset_Ref const *)lua_touserdata(L, 1);
+	object->release();
+
+	return 0;
+}
+
 static luaL_Reg const Shader_Asset_meta[] = {
 	{"__index", Shader_Asset_index},
 	{"__newindex", Shader_Asset_newindex},
 	{"__eq", Shader_Asset_eq},
+	{"__gc", Shader_Asset_gc},
 	// instance:###
 	// Type.###
 	//
@@ -128,10 +138,20 @@ static int Texture_Asset_eq(lua_State * L) {
 	return 1;
 }
 
+static int Texture_Asset_gc(lua_State * L) {
+	typedef custom::Asset_RefT<custom::Texture_Asset> Asset_Ref;
+
+	Asset_Ref const * object = (Asset_Ref const *)lua_touserdata(L, 1);
+	object->release();
+
+	return 0;
+}
+
 static luaL_Reg const Texture_Asset_meta[] = {
 	{"__index", Texture_Asset_index},
 	{"__newindex", Texture_Asset_newindex},
 	{"__eq", Texture_Asset_eq},
+	{"__gc", Texture_Asset_gc},
 	// instance:###
 	// Type.###
 	//
@@ -188,10 +208,20 @@ static int Mesh_Asset_eq(lua_State * L) {
 	return 1;
 }
 
+static int Mesh_Asset_gc(lua_State * L) {
+	typedef custom::Asset_RefT<custom::Mesh_Asset> Asset_Ref;
+
+	Asset_Ref const * object = (Asset_Ref const *)lua_touserdata(L, 1);
+	object->release();
+
+	return 0;
+}
+
 static luaL_Reg const Mesh_Asset_meta[] = {
 	{"__index", Mesh_Asset_index},
 	{"__newindex", Mesh_Asset_newindex},
 	{"__eq", Mesh_Asset_eq},
+	{"__gc", Mesh_Asset_gc},
 	// instance:###
 	// Type.###
 	//
@@ -248,10 +278,20 @@ static int Collider2d_Asset_eq(lua_State * L) {
 	return 1;
 }
 
+static int Collider2d_Asset_gc(lua_State * L) {
+	typedef custom::Asset_RefT<custom::Collider2d_Asset> Asset_Ref;
+
+	Asset_Ref const * object = (Asset_Ref const *)lua_touserdata(L, 1);
+	object->release();
+
+	return 0;
+}
+
 static luaL_Reg const Collider2d_Asset_meta[] = {
 	{"__index", Collider2d_Asset_index},
 	{"__newindex", Collider2d_Asset_newindex},
 	{"__eq", Collider2d_Asset_eq},
+	{"__gc", Collider2d_Asset_gc},
 	// instance:###
 	// Type.###
 	//
@@ -365,10 +405,20 @@ static int Prefab_Asset_promote_to_instance(lua_State * L) {
 	return 1;
 }
 
+static int Prefab_Asset_gc(lua_State * L) {
+	typedef custom::Asset_RefT<custom::Prefab_Asset> Asset_Ref;
+
+	Asset_Ref const * object = (Asset_Ref const *)lua_touserdata(L, 1);
+	object->release();
+
+	return 0;
+}
+
 static luaL_Reg const Prefab_Asset_meta[] = {
 	{"__index", Prefab_Asset_index},
 	{"__newindex", Prefab_Asset_newindex},
 	{"__eq", Prefab_Asset_eq},
+	{"__gc", Prefab_Asset_gc},
 	// instance:###
 	{"instantiate", Prefab_Asset_instantiate},
 	{"promote_to_instance", Prefab_Asset_promote_to_instance},
@@ -427,10 +477,20 @@ static int Config_Asset_eq(lua_State * L) {
 	return 1;
 }
 
+static int Config_Asset_gc(lua_State * L) {
+	typedef custom::Asset_RefT<custom::Config_Asset> Asset_Ref;
+
+	Asset_Ref const * object = (Asset_Ref const *)lua_touserdata(L, 1);
+	object->release();
+
+	return 0;
+}
+
 static luaL_Reg const Config_Asset_meta[] = {
 	{"__index", Config_Asset_index},
 	{"__newindex", Config_Asset_newindex},
 	{"__eq", Config_Asset_eq},
+	{"__gc", Config_Asset_gc},
 	// instance:###
 	// Type.###
 	//
@@ -9,6 +9,7 @@
 #include <lua.hpp>
 
 // @Todo: reuse userdata?
+// @Note: userdata might outlive a pool compaction, hence `relocate`
 
 //
 // Transform
@@ -19,7 +20,8 @@ static int Transform_index(lua_State * L) {
 
 	LUA_INDEX_RAWGET_IMPL(Transform);
 
-	Ref const * object = (Ref const *)lua_touserdata(L, 1);
+	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
 
 	cstring id = lua_tostring(L, 2);
@@ -54,7 +56,9 @@ static int Transform_newindex(lua_State * L) {
 	typedef custom::RefT<Transform> Ref;
 
 	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
+	object->touch();
 
 	cstring id = lua_tostring(L, 2);
 
@@ -117,7 +121,8 @@ static int Camera_index(lua_State * L) {
 
 	LUA_INDEX_RAWGET_IMPL(Camera);
 
-	Ref const * object = (Ref const *)lua_touserdata(L, 1);
+	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
 
 	cstring id = lua_tostring(L, 2);
@@ -138,7 +143,9 @@ static int Camera_newindex(lua_State * L) {
 	typedef custom::RefT<Camera> Ref;
 
 	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
+	object->touch();
 
 	cstring id = lua_tostring(L, 2);
 
@@ -188,7 +195,8 @@ static int Hierarchy_index(lua_State * L) {
 
 	LUA_INDEX_RAWGET_IMPL(Hierarchy);
 
-	Ref const * object = (Ref const *)lua_touserdata(L, 1);
+	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
 
 	cstring id = lua_tostring(L, 2);
@@ -209,6 +217,7 @@ static int Hierarchy_newindex(lua_State * L) {
 	typedef custom::RefT<Hierarchy> Ref;
 
 	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
 
 	cstring id = lua_tostring(L, 2);
@@ -257,6 +266,7 @@ namespace lua {
 
 void init_component_types(lua_State * L) {
 	#define COMPONENT_IMPL(T) LUA_META_IMPL(T)
+	#define TAG_IMPL(T) LUA_TAG_IMPL(T)
 	#include "engine/registry_impl/component_types.h"
 }
 
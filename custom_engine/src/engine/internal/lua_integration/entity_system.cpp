@@ -61,7 +61,8 @@ static int Entity_add_component(lua_State * L) {
 	u32 type = (u32)lua_tointeger(L, 2);
 	Entity * object = (Entity *)lua_touserdata(L, 1);
 	Ref component_ref = object->add_component(type);
-	
+	if (Entity::is_tag(type)) { return 0; }
+
 	Ref * udata = (Ref *)lua_newuserdatauv(L, sizeof(Ref), 0);
 	luaL_setmetatable(L, custom::component_names.get_string(type));
 	*udata = component_ref;
@@ -100,6 +101,7 @@ static int Entity_get_component(lua_State * L) {
 
 	Entity * object = (Entity *)lua_touserdata(L, 1);
 	u32 type = (u32)lua_tointeger(L, 2);
+	if (Entity::is_tag(type)) { lua_pushnil(L); return 1; }
 	Ref component_ref = object->get_component(type);
 
 	bool has_component = (*Entity::vtable.contains[type])(component_ref);
@@ -159,6 +161,41 @@ static int Entity_copy(lua_State * L) {
 	return 1;
 }
 
+static int Entity_copy_many(lua_State * L) {
+	CUSTOM_LUA_ASSERT(lua_gettop(L) == 3, "expected 3 arguments");
+	LUA_ASSERT_USERDATA("Entity", 1);
+	LUA_ASSERT_TYPE(LUA_TNUMBER, 2);
+	LUA_ASSERT_TYPE(LUA_TBOOLEAN, 3);
+
+	// @Note: a bad count would allocate garbage, so it's an error even without asserts;
+	//        copies go to a Lua table, which size is an `int`, and need ids of their own
+	custom::Gen_Pool const & generations = Entity::world->generations;
+	u32 const ids_left = custom::empty_index - (generations.gens.count - generations.gaps.count);
+	lua_Integer const count_limit = (ids_left < (u32)INT_MAX) ? (lua_Integer)ids_left : (lua_Integer)INT_MAX;
+
+	lua_Integer count_integer = lua_tointeger(L, 2);
+	if (count_integer < 0 || count_integer > count_limit) {
+		return luaL_argerror(L, 2, "count should be non-negative and fit the free entity ids");
+	}
+
+	Entity * object = (Entity *)lua_touserdata(L, 1);
+	u32 count = (u32)count_integer;
+	bool force_instance = lua_toboolean(L, 3);
+
+	custom::Array<Entity> copies(count);
+	object->copy_many(count, force_instance, copies);
+
+	lua_createtable(L, (int)copies.count, 0);
+	for (u32 i = 0; i < copies.count; ++i) {
+		Entity * udata = (Entity *)lua_newuserdatauv(L, sizeof(Entity), 0);
+		luaL_setmetatable(L, "Entity");
+		*udata = copies[i];
+		lua_rawseti(L, -2, (lua_Integer)i + 1);
+	}
+
+	return 1;
+}
+
 static int Entity_destroy(lua_State * L) {
 	CUSTOM_LUA_ASSERT(lua_gettop(L) == 1, "expected 1 argument");
 	LUA_ASSERT_USERDATA("Entity", 1);
@@ -169,6 +206,76 @@ static int Entity_destroy(lua_State * L) {
 	return 0;
 }
 
+static int Entity_create_deferred(lua_State * L) {
+	CUSTOM_LUA_ASSERT(lua_gettop(L) == 1, "expected 1 argument");
+	LUA_ASSERT_TYPE(LUA_TBOOLEAN, 1);
+
+	bool is_instance = lua_toboolean(L, 1);
+
+	Entity * udata = (Entity *)lua_newuserdatauv(L, sizeof(Entity), 0);
+	luaL_setmetatable(L, "Entity");
+	*udata = Entity::create_deferred(is_instance);
+
+	return 1;
+}
+
+static int Entity_copy_deferred(lua_State * L) {
+	CUSTOM_LUA_ASSERT(lua_gettop(L) == 2, "expected 2 arguments");
+	LUA_ASSERT_USERDATA("Entity", 1);
+	LUA_ASSERT_TYPE(LUA_TBOOLEAN, 2);
+
+	Entity * object = (Entity *)lua_touserdata(L, 1);
+	bool force_instance = lua_toboolean(L, 2);
+
+	Entity * udata = (Entity *)lua_newuserdatauv(L, sizeof(Entity), 0);
+	luaL_setmetatable(L, "Entity");
+	*udata = object->copy_deferred(force_instance);
+
+	return 1;
+}
+
+static int Entity_destroy_deferred(lua_State * L) {
+	CUSTOM_LUA_ASSERT(lua_gettop(L) == 1, "expected 1 argument");
+	LUA_ASSERT_USERDATA("Entity", 1);
+
+	Entity * object = (Entity *)lua_touserdata(L, 1);
+	object->destroy_deferred();
+
+	return 0;
+}
+
+static int Entity_add_component_deferred(lua_State * L) {
+	CUSTOM_LUA_ASSERT(lua_gettop(L) == 2, "expected 2 arguments");
+	LUA_ASSERT_USERDATA("Entity", 1);
+	LUA_ASSERT_TYPE(LUA_TNUMBER, 2);
+
+	Entity * object = (Entity *)lua_touserdata(L, 1);
+	u32 type = (u32)lua_tointeger(L, 2);
+	object->add_component_deferred(type);
+
+	return 0;
+}
+
+static int Entity_rem_component_deferred(lua_State * L) {
+	CUSTOM_LUA_ASSERT(lua_gettop(L) == 2, "expected 2 arguments");
+	LUA_ASSERT_USERDATA("Entity", 1);
+	LUA_ASSERT_TYPE(LUA_TNUMBER, 2);
+
+	Entity * object = (Entity *)lua_touserdata(L, 1);
+	u32 type = (u32)lua_tointeger(L, 2);
+	object->rem_component_deferred(type);
+
+	return 0;
+}
+
+static int Entity_apply_commands(lua_State * L) {
+	CUSTOM_LUA_ASSERT(lua_gettop(L) == 0, "expected 0 arguments");
+
+	Entity::apply_commands();
+
+	return 0;
+}
+
 static luaL_Reg const Entity_meta[] = {
 	{"__index", Entity_index},
 	{"__newindex", Entity_newindex},
@@ -176,14 +283,21 @@ static luaL_Reg const Entity_meta[] = {
 	// instance:###
 	{"exists",  Entity_exists},
 	{"copy",    Entity_copy},
+	{"copy_many", Entity_copy_many},
 	{"destroy", Entity_destroy},
 	{"add_component", Entity_add_component},
 	{"rem_component", Entity_rem_component},
 	{"has_component", Entity_has_component},
 	{"get_component", Entity_get_component},
+	{"copy_deferred",    Entity_copy_deferred},
+	{"destroy_deferred", Entity_destroy_deferred},
+	{"add_component_deferred", Entity_add_component_deferred},
+	{"rem_component_deferred", Entity_rem_component_deferred},
 	// Type.###
 	{"reset_system", Entity_reset_system},
 	{"create", Entity_create},
+	{"create_deferred", Entity_create_deferred},
+	{"apply_commands", Entity_apply_commands},
 	//
 	{NULL, NULL},
 };
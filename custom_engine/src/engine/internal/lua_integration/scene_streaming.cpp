@@ -0,0 +1,107 @@
+#include "custom_pch.h"
+
+#include "engine/core/code.h"
+#include "engine/debug/log.h"
+#include "engine/api/lua.h"
+#include "engine/api/internal/scene_streaming.h"
+
+#include <lua.hpp>
+
+// @Todo: reuse userdata?
+
+typedef custom::Entity Entity;
+
+// @Note: a scene is represented by its handle
+typedef custom::Ref Scene;
+
+static int Scene_index(lua_State * L) {
+	LUA_INDEX_RAWGET_IMPL(Scene);
+
+	cstring id = lua_tostring(L, 2);
+
+	LUA_REPORT_INDEX();
+	lua_pushnil(L); return 1;
+}
+
+static int Scene_newindex(lua_State * L) {
+	cstring id = lua_tostring(L, 2);
+
+	LUA_REPORT_INDEX();
+	return 0;
+}
+
+static int Scene_load(lua_State * L) {
+	CUSTOM_LUA_ASSERT(lua_gettop(L) == 1, "expected 1 argument");
+	LUA_ASSERT_TYPE(LUA_TSTRING, 1);
+
+	cstring path = lua_tostring(L, 1);
+
+	Scene * udata = (Scene *)lua_newuserdatauv(L, sizeof(Scene), 0);
+	luaL_setmetatable(L, "Scene");
+	*udata = custom::streaming::load(path);
+
+	return 1;
+}
+
+static int Scene_unload(lua_State * L) {
+	CUSTOM_LUA_ASSERT(lua_gettop(L) == 1, "expected 1 argument");
+	LUA_ASSERT_USERDATA("Scene", 1);
+
+	Scene const * object = (Scene const *)lua_touserdata(L, 1);
+	custom::streaming::unload(*object);
+
+	return 0;
+}
+
+static int Scene_is_loaded(lua_State * L) {
+	CUSTOM_LUA_ASSERT(lua_gettop(L) == 1, "expected 1 argument");
+	LUA_ASSERT_USERDATA("Scene", 1);
+
+	Scene const * object = (Scene const *)lua_touserdata(L, 1);
+
+	lua_pushboolean(L, custom::streaming::is_loaded(*object));
+
+	return 1;
+}
+
+static int Scene_get_root(lua_State * L) {
+	CUSTOM_LUA_ASSERT(lua_gettop(L) == 1, "expected 1 argument");
+	LUA_ASSERT_USERDATA("Scene", 1);
+
+	Scene const * object = (Scene const *)lua_touserdata(L, 1);
+
+	Entity root = custom::streaming::get_root(*object);
+	if (!root.exists()) { lua_pushnil(L); return 1; }
+
+	Entity * udata = (Entity *)lua_newuserdatauv(L, sizeof(Entity), 0);
+	luaL_setmetatable(L, "Entity");
+	*udata = root;
+
+	return 1;
+}
+
+static luaL_Reg const Scene_meta[] = {
+	{"__index", Scene_index},
+	{"__newindex", Scene_newindex},
+	// instance:###
+	{"unload", Scene_unload},
+	{"is_loaded", Scene_is_loaded},
+	{"get_root", Scene_get_root},
+	// Type.###
+	{"load", Scene_load},
+	//
+	{NULL, NULL},
+};
+
+//
+//
+//
+
+namespace custom {
+namespace lua {
+
+void init_scene_streaming(lua_State * L) {
+	LUA_META_IMPL(Scene)
+}
+
+}}
@@ -0,0 +1,145 @@
+#include "custom_pch.h"
+#include "engine/core/lz4.h"
+#include "engine/core/code.h"
+#include "engine/core/collection_types.h"
+#include "engine/debug/log.h"
+
+// https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+
+// sequence template
+// token:    0b llllmmmm; literals length and match length minus 4
+// literals: [length extension], [literals]
+// match:    offset (little-endian u16), [length extension]
+// - a length nibble of 15 is followed by bytes up to the first non-255 one
+// - the last sequence only holds literals
+// - the last match starts 12 bytes before the end of a block at least
+// - the last 5 bytes are always literals
+
+namespace custom {
+namespace lz4 {
+
+constexpr static u32 const min_match     = 4;
+constexpr static u32 const last_literals = 5;
+constexpr static u32 const match_limit   = 12;
+constexpr static u32 const max_offset    = 65535;
+constexpr static u32 const hash_log      = 12;
+constexpr static u32 const nibble_max    = 15;
+
+inline static u32 read_u32(u8 const * data) {
+	u32 value; memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+inline static u32 hash_sequence(u32 sequence) {
+	return (sequence * 2654435761U) >> (32 - hash_log);
+}
+
+inline static u8 * write_length(u8 * out, u32 length) {
+	for (; length >= 255; length -= 255) { *(out++) = 255; }
+	*(out++) = (u8)length;
+	return out;
+}
+
+static u8 * write_sequence(u8 * out, u8 const * literals, u32 literals_count, u32 offset, u32 match_length) {
+	u8 * token = out++;
+	*token = (u8)((literals_count < nibble_max ? literals_count : nibble_max) << 4);
+	if (literals_count >= nibble_max) { out = write_length(out, literals_count - nibble_max); }
+	memcpy(out, literals, literals_count); out += literals_count;
+
+	if (!match_length) { return out; }
+
+	*(out++) = (u8)(offset & 0xff);
+	*(out++) = (u8)(offset >> 8);
+
+	u32 length = match_length - min_match;
+	*token |= (u8)(length < nibble_max ? length : nibble_max);
+	if (length >= nibble_max) { out = write_length(out, length - nibble_max); }
+	return out;
+}
+
+u32 get_bound(u32 count) {
+	return count + count / 255 + 16;
+}
+
+u32 compress(u8 const * source, u32 count, u8 * destination) {
+	u32 table[1 << hash_log];
+	for (u32 i = 0; i < C_ARRAY_LENGTH(table); ++i) { table[i] = custom::empty_index; }
+
+	u8 * out = destination;
+	u32 anchor = 0;
+
+	// @Note: greedy matching of the latest position with the same hash
+	u32 position = 0;
+	while (count > match_limit && position <= count - match_limit) {
+		u32 sequence = read_u32(source + position);
+		u32 hash = hash_sequence(sequence);
+		u32 candidate = table[hash];
+		table[hash] = position;
+
+		bool is_match = (candidate != custom::empty_index)
+		             && (position - candidate <= max_offset)
+		             && (read_u32(source + candidate) == sequence);
+		if (!is_match) { ++position; continue; }
+
+		u32 length = min_match;
+		u32 length_limit = count - last_literals - position;
+		while (length < length_limit && source[candidate + length] == source[position + length]) { ++length; }
+
+		out = write_sequence(out, source + anchor, position - anchor, position - candidate, length);
+		position += length;
+		anchor = position;
+	}
+
+	out = write_sequence(out, source + anchor, count - anchor, 0, 0);
+	return (u32)(out - destination);
+}
+
+bool decompress(u8 const * source, u32 count, u8 * destination, u32 destination_count) {
+	u8 const * in     = source;
+	u8 const * in_end = source + count;
+	u8 * out          = destination;
+	u8 * out_end      = destination + destination_count;
+
+	while (in < in_end) {
+		u8 token = *(in++);
+
+		u32 literals_count = token >> 4;
+		if (literals_count == nibble_max) {
+			u8 value;
+			do {
+				if (in >= in_end) { return false; }
+				value = *(in++); literals_count += value;
+			} while (value == 255);
+		}
+		if ((u32)(in_end - in) < literals_count) { return false; }
+		if ((u32)(out_end - out) < literals_count) { return false; }
+		memcpy(out, in, literals_count);
+		in += literals_count; out += literals_count;
+
+		if (in == in_end) { break; }
+
+		if (in_end - in < 2) { return false; }
+		u32 offset = (u32)in[0] | ((u32)in[1] << 8); in += 2;
+		if (!offset || offset > (u32)(out - destination)) { return false; }
+
+		u32 match_length = token & nibble_max;
+		if (match_length == nibble_max) {
+			u8 value;
+			do {
+				if (in >= in_end) { return false; }
+				value = *(in++); match_length += value;
+			} while (value == 255);
+		}
+		match_length += min_match;
+		if ((u32)(out_end - out) < match_length) { return false; }
+
+		// @Note: a match might overlap its own output, so copy byte by byte
+		u8 const * match = out - offset;
+		for (u32 i = 0; i < match_length; ++i) { out[i] = match[i]; }
+		out += match_length;
+	}
+
+	return out == out_end;
+}
+
+}}
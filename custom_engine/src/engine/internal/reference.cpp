@@ -5,6 +5,7 @@
 
 #include "engine/impl/array.h"
 #include "engine/impl/reference.h"
+#include "engine/impl/bytecode.h"
 
 //
 // pool
@@ -12,6 +13,12 @@
 
 namespace custom {
 
+u32 change_tick = 1;
+
+}
+
+namespace custom {
+
 Ref Gen_Pool::create(void) {
 	u32 id;
 	if (gaps.count > 0) {
@@ -22,7 +29,7 @@ Ref Gen_Pool::create(void) {
 		id = gens.count;
 		u32 capacity_before = gens.capacity;
 		gens.push();
-		for (u32 i = capacity_before; i < gens.capacity; ++i) { gens.data[i] = 0; }
+		for (u32 i = capacity_before; i < gens.capacity; ++i) { gens.data[i] = fresh_gen; }
 	}
 	return { id, gens[id] };
 }
@@ -42,4 +49,56 @@ void Gen_Pool::destroy(Ref const & ref) {
 	}
 }
 
+void Gen_Pool::ensure_capacity(u32 number) {
+	u32 capacity_before = gens.capacity;
+	gens.ensure_capacity(number);
+	for (u32 i = capacity_before; i < gens.capacity; ++i) { gens.data[i] = fresh_gen; }
+}
+
+u32 Gen_Pool::append(u32 count) {
+	// @Note: slots past `count` hold fresh generations already
+	u32 first = gens.count;
+	ensure_capacity(first + count);
+	gens.count += count;
+	return first;
+}
+
+void Gen_Pool::write(Bytecode & bc) const {
+	bc.write(gens.count);
+	bc.write(gens.data, gens.count);
+	bc.write(gaps.count);
+	bc.write(gaps.data, gaps.count);
+	bc.write(fresh_gen);
+}
+
+bool Gen_Pool::read(Bytecode const & bc) {
+	u32 const offset = bc.read_offset;
+
+	if (!bc.can_read<u32>()) { return false; }
+	u32 gens_count = *bc.read<u32>();
+	if (!bc.can_read<u32>(gens_count)) { bc.read_offset = offset; return false; }
+	u32 const * gens_data = bc.read<u32>(gens_count);
+
+	if (!bc.can_read<u32>()) { bc.read_offset = offset; return false; }
+	u32 gaps_count = *bc.read<u32>();
+	if (gaps_count > gens_count || !bc.can_read<u32>(gaps_count)) { bc.read_offset = offset; return false; }
+	u32 const * gaps_data = bc.read<u32>(gaps_count);
+	for (u32 i = 0; i < gaps_count; ++i) {
+		if (gaps_data[i] >= gens_count) { bc.read_offset = offset; return false; }
+	}
+
+	if (!bc.can_read<u32>()) { bc.read_offset = offset; return false; }
+	fresh_gen = *bc.read<u32>();
+
+	gens.count = 0; ensure_capacity(gens_count);
+	memcpy(gens.data, gens_data, gens_count * sizeof(u32));
+	gens.count = gens_count;
+
+	gaps.count = 0; gaps.ensure_capacity(gaps_count);
+	memcpy(gaps.data, gaps_data, gaps_count * sizeof(u32));
+	gaps.count = gaps_count;
+
+	return true;
+}
+
 }
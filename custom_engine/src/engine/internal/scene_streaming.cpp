@@ -0,0 +1,318 @@
+#include "custom_pch.h"
+
+#include "engine/core/code.h"
+#include "engine/debug/log.h"
+#include "engine/api/platform/file.h"
+#include "engine/api/platform/thread.h"
+#include "engine/api/internal/names_lookup.h"
+#include "engine/api/internal/asset_pack.h"
+#include "engine/api/internal/asset_system.h"
+#include "engine/api/internal/component_types.h"
+#include "engine/api/internal/scene_streaming.h"
+#include "engine/impl/array.h"
+#include "engine/impl/entity_system.h"
+
+namespace custom {
+namespace streaming {
+
+struct Scene {
+	enum struct Status : u8 {Loading, Loaded, Unloading};
+	Status status;
+	b8     is_unload_requested;
+
+	Array<char>               path;
+	Entity::State *           world; // staging; `NULL` once merged
+	thread::Background_Task * task;
+
+	// staging
+	Strings_Storage entity_strings;  // starts as a copy of `Entity::strings`
+	u32             entity_strings_known;
+	Asset::Staging  assets;
+	u32             asset_strings_known;
+	Array<Entity>   prefabs;
+	Array<u32>      prefab_paths;
+
+	// merged
+	Entity        root;
+	Array<Entity> entities; // per staging entity id
+};
+
+}}
+
+//  @Note: initialize compile-time structs:
+template struct custom::Array<custom::streaming::Scene *>;
+
+namespace custom {
+namespace streaming {
+
+struct Streaming_Data {
+	Gen_Pool       generations;
+	Array<Scene *> scenes; // sparse
+	u32            unload_budget = 256;
+	b8             is_warmed_up;
+};
+
+static Streaming_Data streaming_data;
+static thread_local Scene * staging_scene = NULL;
+
+static void strings_copy(Strings_Storage const & source, Strings_Storage & strings) {
+	if (!source.get_count()) { return; }
+	strings.values.push_range(source.values.data, source.values.count);
+	strings.offsets.push_range(source.offsets.data, source.offsets.count);
+	strings.lengths.push_range(source.lengths.data, source.lengths.count);
+}
+
+static void strings_free(Strings_Storage & strings) {
+	strings.values.set_capacity(0);
+	strings.offsets.set_capacity(0);
+	strings.lengths.set_capacity(0);
+}
+
+// @Note: copies are prefixed with the shared storage, so known ids stay the same
+static void strings_remap(Strings_Storage const & source, u32 known, Strings_Storage & strings, Array<u32> & remap) {
+	remap.ensure_capacity(source.get_count());
+	for (u32 i = 0; i < known; ++i) {
+		remap.push(i);
+	}
+	for (u32 i = known; i < source.get_count(); ++i) {
+		remap.push(strings.store_string(source.get_string(i), source.get_length(i)));
+	}
+}
+
+// @Note: child blocks inherit `is_instance` of their parent, so it's up to the root;
+//        scenes are instances, prefabs are templates
+static Entity read_entity(cstring path, bool is_instance) {
+	file::View view = {}; Array<u8> buffer;
+	bool is_mapped = false;
+	if (!pack::read(path, view, buffer)) {
+		// @Note: a mapping is followed by a zero byte, unless it ends on a page boundary
+		if (file::map(path, view)) {
+			is_mapped = (view.count % file::get_page_size()) != 0;
+			if (!is_mapped) { file::unmap(view); }
+		}
+		if (!is_mapped) {
+			if (!file::read(path, buffer)) { CUSTOM_ASSERT(false, "failed to read file: '%s'", path); return {custom::empty_ref}; }
+			buffer.push('\0'); --buffer.count;
+			view = {buffer.data, buffer.count};
+		}
+	}
+
+	cstring source = (cstring)view.data;
+	Entity entity = Entity::create(is_instance);
+	entity.read(&source);
+
+	if (is_mapped) { file::unmap(view); }
+	return entity;
+}
+
+// @Note: readers intern their keys into `Entity::strings` upon the first call;
+//        make sure it happens on the main thread, instead of a staging copy
+static void warm_up_readers(void) {
+	Entity::State * world = Entity::create_world();
+	Entity::State * previous = Entity::bind_world(world);
+
+	// @Note: `Hierarchy` isn't readable and has no keys either
+	Entity entity = Entity::create(false);
+	for (u32 type = 0; type < Entity::vtable.read.count; ++type) {
+		if (Entity::is_tag(type)) { continue; }
+		if (type == Component_Registry<Hierarchy>::type) { continue; }
+		cstring source = custom::component_names.get_string(type);
+		Ref component_ref = entity.add_component(type);
+		(*Entity::vtable.read[type])(entity, component_ref, &source);
+	}
+
+	Entity::bind_world(previous);
+	Entity::destroy_world(world);
+	streaming_data.is_warmed_up = true;
+}
+
+static THREAD_TASK_FUNC(stream_task) {
+	Scene * scene = (Scene *)data;
+	staging_scene           = scene;
+	Entity::staging_strings = &scene->entity_strings;
+	Asset::staging          = &scene->assets;
+	Entity::bind_world(scene->world);
+
+	scene->root = read_entity(scene->path.data, true);
+
+	// @Note: prefabs are templates, not parts of the scene
+	for (u32 i = 0; i < scene->prefabs.count; ++i) {
+		if (!scene->prefabs[i].exists()) { continue; }
+		scene->prefabs[i].destroy();
+	}
+
+	Entity::bind_world(NULL);
+	Asset::staging          = NULL;
+	Entity::staging_strings = NULL;
+	staging_scene           = NULL;
+}
+
+static void scene_merge(Scene & scene) {
+	Snapshot_Remap remap;
+	strings_remap(scene.entity_strings, scene.entity_strings_known, Entity::strings, remap.entity_strings);
+	strings_remap(scene.assets.strings, scene.asset_strings_known, Asset::strings, remap.asset_strings);
+
+	// @Note: add assets the readers have asked for, e.g. scripts, which aren't
+	//        necessarily referenced by components
+	for (u32 i = 0; i < scene.assets.types.count; ++i) {
+		Asset::add_async(scene.assets.types[i], remap.get_asset_string(scene.assets.resources[i]));
+	}
+
+	u32 root_id = scene.root.id;
+	Entity::merge_world(scene.world, &remap, scene.entities);
+	scene.world = NULL;
+	scene.root = (root_id < scene.entities.count) ? scene.entities[root_id] : Entity{custom::empty_ref};
+
+	strings_free(scene.entity_strings);
+	strings_free(scene.assets.strings);
+	scene.assets.types.set_capacity(0);
+	scene.assets.resources.set_capacity(0);
+	scene.prefabs.set_capacity(0);
+	scene.prefab_paths.set_capacity(0);
+}
+
+static void scene_free(Ref const & ref) {
+	Scene * scene = streaming_data.scenes.get(ref.id);
+	if (scene->task) { thread::join(scene->task); }
+	if (scene->world) { Entity::destroy_world(scene->world); }
+	scene->~Scene();
+	free(scene);
+
+	streaming_data.scenes.get(ref.id) = NULL;
+	streaming_data.generations.destroy(ref);
+}
+
+}}
+
+//
+// API implementation
+//
+
+namespace custom {
+namespace streaming {
+
+Ref load(cstring path) {
+	if (!streaming_data.is_warmed_up) { warm_up_readers(); }
+
+	// @Note: arrays are POD, zeroes stand for empty ones
+	Scene * scene = (Scene *)calloc(1, sizeof(Scene));
+	scene->status = Scene::Status::Loading;
+	scene->path.push_range(path, (u32)strlen(path) + 1);
+	scene->world = Entity::create_world();
+	scene->root  = {custom::empty_ref};
+
+	strings_copy(Entity::strings, scene->entity_strings);
+	strings_copy(Asset::strings, scene->assets.strings);
+	scene->entity_strings_known = Entity::strings.get_count();
+	scene->asset_strings_known  = Asset::strings.get_count();
+
+	Ref ref = streaming_data.generations.create();
+	streaming_data.scenes.ensure_capacity(ref.id + 1);
+	streaming_data.scenes.get(ref.id) = scene;
+
+	scene->task = thread::start(&stream_task, scene);
+	return ref;
+}
+
+void unload(Ref const & ref) {
+	if (!streaming_data.generations.contains(ref)) { CUSTOM_ASSERT(false, "scene doesn't exist"); return; }
+
+	Scene * scene = streaming_data.scenes.get(ref.id);
+	switch (scene->status) {
+		case Scene::Status::Loading:   scene->is_unload_requested = true; break;
+		case Scene::Status::Loaded:    scene->status = Scene::Status::Unloading; break;
+		case Scene::Status::Unloading: break;
+	}
+}
+
+bool is_loaded(Ref const & ref) {
+	if (!streaming_data.generations.contains(ref)) { return false; }
+	return streaming_data.scenes.get(ref.id)->status == Scene::Status::Loaded;
+}
+
+Entity get_root(Ref const & ref) {
+	if (!is_loaded(ref)) { return {custom::empty_ref}; }
+	return streaming_data.scenes.get(ref.id)->root;
+}
+
+void set_unload_budget(u32 entities_per_frame) {
+	streaming_data.unload_budget = entities_per_frame;
+}
+
+void update(void) {
+	CUSTOM_ASSERT(Entity::world == &Entity::state, "streaming targets the default world");
+
+	u32 budget = streaming_data.unload_budget;
+	for (u32 id = 0; id < streaming_data.generations.gens.count; ++id) {
+		Ref ref = {id, streaming_data.generations.gens[id]};
+		Scene * scene = streaming_data.scenes.get(id);
+		if (!scene) { continue; }
+
+		switch (scene->status) {
+			case Scene::Status::Loading: {
+				if (!thread::is_done(scene->task)) { break; }
+				thread::join(scene->task); scene->task = NULL;
+
+				// @Note: an unwanted staging world is dropped as a whole
+				if (scene->is_unload_requested) { scene_free(ref); break; }
+
+				scene_merge(*scene);
+				scene->status = Scene::Status::Loaded;
+			} break;
+
+			case Scene::Status::Loaded: break;
+
+			case Scene::Status::Unloading: {
+				// @Note: children are created after their parents, so destroying
+				//        from the end removes leaves first and keeps each call cheap
+				while (budget > 0 && scene->entities.count > 0) {
+					Entity entity = scene->entities[scene->entities.count - 1];
+					scene->entities.pop();
+					if (!entity.exists()) { continue; }
+					entity.destroy();
+					--budget;
+				}
+				if (!scene->entities.count) { scene_free(ref); }
+			} break;
+		}
+	}
+}
+
+void shutdown(void) {
+	for (u32 id = 0; id < streaming_data.generations.gens.count; ++id) {
+		if (!streaming_data.scenes.get(id)) { continue; }
+		scene_free({id, streaming_data.generations.gens[id]});
+	}
+	streaming_data.scenes.set_capacity(0);
+	streaming_data.generations.gens.set_capacity(0);
+	streaming_data.generations.gaps.set_capacity(0);
+}
+
+}}
+
+//
+// staging API implementation
+//
+
+namespace custom {
+namespace streaming {
+
+bool is_staging(void) {
+	return staging_scene != NULL;
+}
+
+Entity get_prefab(u32 path_id) {
+	Scene * scene = staging_scene;
+	if (!scene) { CUSTOM_ASSERT(false, "not a staging thread"); return {custom::empty_ref}; }
+
+	for (u32 i = 0; i < scene->prefab_paths.count; ++i) {
+		if (scene->prefab_paths[i] == path_id) { return scene->prefabs[i]; }
+	}
+
+	Entity prefab = read_entity(Asset::get_string(path_id), false);
+	scene->prefabs.push(prefab);
+	scene->prefab_paths.push(path_id);
+	return prefab;
+}
+
+}}
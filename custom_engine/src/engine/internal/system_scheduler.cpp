@@ -0,0 +1,116 @@
+#include "custom_pch.h"
+
+#include "engine/core/code.h"
+#include "engine/debug/log.h"
+#include "engine/api/platform/thread.h"
+#include "engine/api/internal/system_scheduler.h"
+#include "engine/impl/array.h"
+
+namespace custom {
+namespace scheduler {
+
+struct Task {
+	u32 system;
+	u32 chunk;
+};
+
+}}
+
+//  @Note: initialize compile-time structs:
+template struct custom::Array<custom::scheduler::System>;
+template struct custom::Array<custom::scheduler::Task>;
+
+namespace custom {
+namespace scheduler {
+
+struct Scheduler_Data {
+	Array<System> systems;
+	Array<u32>    stages; // per system
+	u32           stages_count;
+	bool          is_dirty;
+
+	Array<Task> tasks;
+	r32         dt;
+};
+
+static Scheduler_Data scheduler_data;
+
+static bool systems_conflict(System const & first, System const & second) {
+	if (first.writes & (second.reads | second.writes)) { return true; }
+	if (second.writes & first.reads) { return true; }
+	return false;
+}
+
+// @Note: a system goes to the stage right after the latest conflicting one,
+//        which keeps the order of addition for anything dependent
+static void build_stages(void) {
+	scheduler_data.stages.count = 0;
+	scheduler_data.stages.ensure_capacity(scheduler_data.systems.count);
+	scheduler_data.stages_count = 0;
+
+	for (u32 i = 0; i < scheduler_data.systems.count; ++i) {
+		u32 stage = 0;
+		for (u32 j = 0; j < i; ++j) {
+			if (!systems_conflict(scheduler_data.systems[j], scheduler_data.systems[i])) { continue; }
+			if (stage <= scheduler_data.stages[j]) { stage = scheduler_data.stages[j] + 1; }
+		}
+		scheduler_data.stages.push(stage);
+		if (scheduler_data.stages_count <= stage) { scheduler_data.stages_count = stage + 1; }
+	}
+
+	scheduler_data.is_dirty = false;
+}
+
+static THREAD_TASK_FUNC(run_task) {
+	Task const & task = scheduler_data.tasks[index];
+	System const & system = scheduler_data.systems[task.system];
+	(*system.callback)(scheduler_data.dt, task.chunk, system.chunks);
+}
+
+void add_system(System const & system) {
+	CUSTOM_ASSERT(system.callback, "system has no callback");
+	CUSTOM_ASSERT(system.chunks, "system has no chunks");
+	scheduler_data.systems.push(system);
+	scheduler_data.is_dirty = true;
+}
+
+void reset(void) {
+	scheduler_data.systems.count = 0;
+	scheduler_data.is_dirty = true;
+}
+
+void update(r32 dt) {
+	if (scheduler_data.is_dirty) { build_stages(); }
+	scheduler_data.dt = dt;
+
+	for (u32 stage = 0; stage < scheduler_data.stages_count; ++stage) {
+		scheduler_data.tasks.count = 0;
+		for (u32 i = 0; i < scheduler_data.systems.count; ++i) {
+			if (scheduler_data.stages[i] != stage) { continue; }
+
+			System const & system = scheduler_data.systems[i];
+			if (system.main_thread) { continue; }
+
+			for (u32 chunk = 0; chunk < system.chunks; ++chunk) {
+				scheduler_data.tasks.push({i, chunk});
+			}
+		}
+
+		// @Note: systems of a stage don't conflict, so main thread ones
+		//        run while the workers are busy with the rest
+		custom::thread::run_async(&run_task, NULL, scheduler_data.tasks.count);
+		for (u32 i = 0; i < scheduler_data.systems.count; ++i) {
+			if (scheduler_data.stages[i] != stage) { continue; }
+
+			System const & system = scheduler_data.systems[i];
+			if (!system.main_thread) { continue; }
+
+			for (u32 chunk = 0; chunk < system.chunks; ++chunk) {
+				(*system.callback)(dt, chunk, system.chunks);
+			}
+		}
+		custom::thread::wait();
+	}
+}
+
+}}
@@ -1,9 +1,15 @@
 // @Note: utility for automatic registration of component types:
 //        - #define a COMPONENT_IMPL(T) macro
+//        - #define a TAG_IMPL(T) macro, optionally; tags have no data and no pool,
+//          only a bit of the entity signature
 //        - #include this file
 COMPONENT_IMPL(Transform)
 COMPONENT_IMPL(Camera)
 COMPONENT_IMPL(Hierarchy)
 // COMPONENT_IMPL(Transform2d)
 //
+#if defined(TAG_IMPL)
+// TAG_IMPL(Disabled)
+#undef TAG_IMPL
+#endif
 #undef COMPONENT_IMPL
@@ -135,7 +135,7 @@ struct Mesh
 	u32 gen;
 	GLuint id = empty_gl_id;
 	u32 ready_state = RS_NONE;
-	custom::Array_Fixed<Buffer, 2> buffers;
+	custom::Array_Fixed<Buffer, 3> buffers;
 	u8 index_buffer;
 
 	~Mesh() {
@@ -988,6 +988,17 @@ static GLenum get_data_type(Data_Type value) {
 	return GL_NONE;
 }
 
+// @Note: integer vertex attributes are read as normalized floats, e.g. quantized normals
+static GLboolean get_normalized(Data_Type value) {
+	switch (value) {
+		case Data_Type::s8:  return GL_TRUE;
+		case Data_Type::s16: return GL_TRUE;
+		case Data_Type::u8:  return GL_TRUE;
+		case Data_Type::u16: return GL_TRUE;
+		default:             return GL_FALSE;
+	}
+}
+
 extern u16 get_type_size(Data_Type value);
 
 namespace { struct C_Memory { u32 count; cmemory data; }; }
@@ -1394,11 +1405,14 @@ static void platform_Allocate_Mesh(Bytecode const & bc) {
 	}
 
 	// -- chart memory --
+	// @Note: attribute locations run through all the vertex buffers
+	GLuint location = 0;
 	if (ogl.version >= COMPILE_VERSION(4, 5)) {
 		for (u16 i = 0; i < resource->buffers.count; ++i) {
 			Buffer & buffer = resource->buffers[i];
 			u16 element_size = get_type_size(buffer.type);
 			GLenum element_type = get_data_type(buffer.type);
+			GLboolean is_normalized = get_normalized(buffer.type);
 
 			GLsizei stride = 0;
 			for (u8 attr_i = 0; attr_i < buffer.attributes.count; ++attr_i) {
@@ -1415,13 +1429,14 @@ static void platform_Allocate_Mesh(Bytecode const & bc) {
 			GLuint attrib_offset = 0;
 			for (u8 attr_i = 0; attr_i < buffer.attributes.count; ++attr_i) {
 				Attribute & attr = buffer.attributes[attr_i];
-				glEnableVertexArrayAttrib(resource->id, attr_i);
+				glEnableVertexArrayAttrib(resource->id, location);
 				glVertexArrayAttribFormat(
 					resource->id,
-					attr_i, attr.count, element_type, false, attrib_offset
+					location, attr.count, element_type, is_normalized, attrib_offset
 				);
-				glVertexArrayAttribBinding(resource->id, attr_i, i);
+				glVertexArrayAttribBinding(resource->id, location, i);
 				attrib_offset += attr.count * element_size;
+				++location;
 			}
 		}
 	}
@@ -1431,6 +1446,7 @@ static void platform_Allocate_Mesh(Bytecode const & bc) {
 				Buffer & buffer = resource->buffers[i];
 				u16 element_size = get_type_size(buffer.type);
 				GLenum element_type = get_data_type(buffer.type);
+				GLboolean is_normalized = get_normalized(buffer.type);
 
 				GLsizei stride = 0;
 				for (u8 attr_i = 0; attr_i < buffer.attributes.count; ++attr_i) {
@@ -1444,12 +1460,13 @@ static void platform_Allocate_Mesh(Bytecode const & bc) {
 				GLuint attrib_offset = 0;
 				for (u8 attr_i = 0; attr_i < buffer.attributes.count; ++attr_i) {
 					Attribute & attr = buffer.attributes[attr_i];
-					glEnableVertexAttribArray(attr_i);
+					glEnableVertexAttribArray(location);
 					glVertexAttribFormat(
-						attr_i, attr.count, element_type, false, attrib_offset
+						location, attr.count, element_type, is_normalized, attrib_offset
 					);
-					glVertexAttribBinding(attr_i, i);
+					glVertexAttribBinding(location, i);
 					attrib_offset += attr.count * element_size;
+					++location;
 				}
 			}
 		}
@@ -1458,6 +1475,7 @@ static void platform_Allocate_Mesh(Bytecode const & bc) {
 				Buffer & buffer = resource->buffers[i];
 				u16 element_size = get_type_size(buffer.type);
 				GLenum element_type = get_data_type(buffer.type);
+				GLboolean is_normalized = get_normalized(buffer.type);
 		
 				GLsizei stride = 0;
 				for (u8 attr_i = 0; attr_i < buffer.attributes.count; ++attr_i) {
@@ -1470,12 +1488,13 @@ static void platform_Allocate_Mesh(Bytecode const & bc) {
 				uptr attrib_offset = 0;
 				for (u8 attr_i = 0; attr_i < buffer.attributes.count; ++attr_i) {
 					Attribute & attr = buffer.attributes[attr_i];
-					glEnableVertexAttribArray(attr_i);
+					glEnableVertexAttribArray(location);
 					glVertexAttribPointer(
-						attr_i, attr.count, element_type, false,
+						location, attr.count, element_type, is_normalized,
 						stride, (cmemory)attrib_offset
 					);
 					attrib_offset += attr.count * element_size;
+					++location;
 				}
 			}
 		}
@@ -137,8 +137,8 @@ bool read(cstring path, Array<u8> & buffer) {
 		CUSTOM_TRACE("failed to get file size: `%s`", path);
 		return false;
 	}
-	// @Todo: unlock file size from u32 type?
-	CUSTOM_ASSERT(file_size_li.QuadPart <= UINT_MAX, "@Todo: file is too large: `%s`\n    size is %lld", path, file_size_li.QuadPart);
+	// @Note: arrays are limited to u32 sizes; `map` larger files instead
+	CUSTOM_ASSERT(file_size_li.QuadPart < UINT_MAX, "@Todo: file is too large: `%s`\n    size is %lld", path, file_size_li.QuadPart);
 	u32 file_size = (u32)file_size_li.QuadPart;
 
 	// @Note: allocate an additional byte for potential '\0'
@@ -165,6 +165,75 @@ bool read(cstring path, Array<u8> & buffer) {
 	return true;
 }
 
+bool map(cstring path, View & view) {
+	view = {};
+
+	HANDLE handle = CreateFile(
+		path,
+		GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+		NULL
+	);
+	if (handle == INVALID_HANDLE_VALUE) {
+		LOG_LAST_ERROR();
+		CUSTOM_TRACE("failed to open file: `%s`", path);
+		return false;
+	}
+
+	Defer_Scoped defer_file([&](){
+		CloseHandle(handle);
+	});
+
+	LARGE_INTEGER file_size_li;
+	if (!GetFileSizeEx(handle, &file_size_li)) {
+		LOG_LAST_ERROR();
+		CUSTOM_TRACE("failed to get file size: `%s`", path);
+		return false;
+	}
+	if (!file_size_li.QuadPart) {
+		CUSTOM_TRACE("can't map an empty file: `%s`", path);
+		return false;
+	}
+
+	// @Note: the view keeps the mapping and the file open, so handles can be closed right away
+	HANDLE mapping = CreateFileMapping(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mapping) {
+		LOG_LAST_ERROR();
+		CUSTOM_TRACE("failed to create file mapping: `%s`", path);
+		return false;
+	}
+
+	Defer_Scoped defer_mapping([&](){
+		CloseHandle(mapping);
+	});
+
+	void * data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data) {
+		LOG_LAST_ERROR();
+		CUSTOM_TRACE("failed to map view of file: `%s`", path);
+		return false;
+	}
+
+	view.data  = (u8 const *)data;
+	view.count = (u64)file_size_li.QuadPart;
+	return true;
+}
+
+void unmap(View & view) {
+	if (view.data && !UnmapViewOfFile(view.data)) { LOG_LAST_ERROR(); }
+	view = {};
+}
+
+u32 get_page_size(void) {
+	static u32 page_size = 0;
+	if (!page_size) {
+		SYSTEM_INFO system_info;
+		GetSystemInfo(&system_info);
+		page_size = (u32)system_info.dwPageSize;
+	}
+	return page_size;
+}
+
 static Watch_Files_Data watch_data;
 void watch_init(cstring path, bool subtree) {
 	watch_data.path          = path;
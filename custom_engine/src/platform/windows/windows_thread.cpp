@@ -0,0 +1,332 @@
+#include "custom_pch.h"
+#include "engine/api/platform/thread.h"
+#include "engine/core/collection_types.h"
+#include "engine/core/code.h"
+#include "engine/debug/log.h"
+
+#if !defined(CUSTOM_PRECOMPILED_HEADER)
+	#include <Windows.h>
+#endif
+
+#if !defined(CUSTOM_SHIPPING)
+	void log_last_error(cstring source);
+	#define LOG_LAST_ERROR() log_last_error(CUSTOM_FILE_AND_LINE)
+#else
+	#define LOG_LAST_ERROR() (void)0
+#endif
+
+// https://docs.microsoft.com/en-us/windows/win32/sync/using-semaphore-objects
+// https://docs.microsoft.com/en-us/windows/win32/api/winnt/nf-winnt-interlockedincrement
+
+//
+//
+//
+
+namespace {
+
+constexpr static u32 const workers_limit = 63;
+constexpr static u32 const queue_limit   = 64;
+
+struct Job {
+	custom::thread::task_func * task;
+	void * data;
+	u32    count;
+	// @Note: a worker might wake up late, when the job it has been woken for is over
+	//        and the next one is being set up; the generation in the high half lets
+	//        it notice that, while the low half is the next task index to claim
+	volatile LONG64 claims;
+	volatile LONG   remaining; // tasks yet to complete
+};
+
+struct Workers_Data {
+	HANDLE threads[workers_limit];
+	u32    count;
+
+	HANDLE wake_semaphore = NULL;
+	HANDLE done_event     = NULL;
+	volatile LONG should_quit;
+
+	Job  job;
+	u32  generation;
+	bool is_job_running;
+
+	// @Note: background tasks, which still have calls to claim
+	CRITICAL_SECTION queue_lock;
+	custom::thread::Background_Task * queue[queue_limit];
+	u32 queue_count;
+};
+
+}
+
+static Workers_Data workers;
+
+namespace custom {
+namespace thread {
+
+struct Background_Task {
+	HANDLE handle; // a dedicated thread; `NULL` if the workers take care of the calls
+	task_func * task;
+	void * data;
+	u32    count;
+	u32    next; // guarded by `queue_lock`
+	volatile LONG remaining;
+	HANDLE done_event;
+};
+
+}}
+
+//
+// API implementation
+//
+
+static DWORD WINAPI platform_worker_thread(LPVOID lpParam);
+static DWORD WINAPI platform_background_thread(LPVOID lpParam);
+static void platform_do_job(Job & job);
+static void platform_start_job(custom::thread::task_func * task, void * data, u32 count, u32 helpers_count);
+static bool platform_do_background_call(custom::thread::Background_Task * only);
+static custom::thread::Background_Task * platform_start_dedicated(custom::thread::Background_Task * background_task);
+
+namespace custom {
+namespace thread {
+
+void init(u32 workers_count) {
+	if (workers_count == custom::empty_index) {
+		SYSTEM_INFO system_info;
+		GetSystemInfo(&system_info);
+		workers_count = system_info.dwNumberOfProcessors > 1 ? (u32)system_info.dwNumberOfProcessors - 1 : 0;
+	}
+	if (workers_count > workers_limit) { workers_count = workers_limit; }
+
+	InitializeCriticalSection(&workers.queue_lock);
+	workers.queue_count = 0;
+
+	// @Note: spare wake-ups are harmless, so the semaphore isn't limited by the workers count
+	workers.should_quit = 0;
+	workers.wake_semaphore = CreateSemaphore(NULL, 0, MAXLONG, NULL);
+	if (!workers.wake_semaphore) { LOG_LAST_ERROR(); return; }
+
+	workers.done_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+	if (!workers.done_event) { LOG_LAST_ERROR(); return; }
+
+	workers.count = 0;
+	for (u32 i = 0; i < workers_count; ++i) {
+		HANDLE thread_handle = CreateThread(NULL, 0, platform_worker_thread, NULL, 0, NULL);
+		if (!thread_handle) { LOG_LAST_ERROR(); break; }
+		workers.threads[workers.count++] = thread_handle;
+	}
+}
+
+void shutdown(void) {
+	CUSTOM_ASSERT(!workers.queue_count, "background tasks are still running");
+
+	if (workers.count) {
+		InterlockedExchange(&workers.should_quit, 1);
+		ReleaseSemaphore(workers.wake_semaphore, (LONG)workers.count, NULL);
+		WaitForMultipleObjects((DWORD)workers.count, workers.threads, TRUE, INFINITE);
+		for (u32 i = 0; i < workers.count; ++i) { CloseHandle(workers.threads[i]); }
+		workers.count = 0;
+	}
+
+	DeleteCriticalSection(&workers.queue_lock);
+	if (workers.done_event) { CloseHandle(workers.done_event); workers.done_event = NULL; }
+	if (workers.wake_semaphore) { CloseHandle(workers.wake_semaphore); workers.wake_semaphore = NULL; }
+}
+
+u32 get_workers_count(void) {
+	return workers.count;
+}
+
+void run(task_func * task, void * data, u32 count) {
+	if (workers.is_job_running) { CUSTOM_ASSERT(false, "a job is running already"); wait(); }
+	if (count == 0) { return; }
+
+	u32 helpers_count = (count - 1 < workers.count) ? count - 1 : workers.count;
+	if (helpers_count == 0) {
+		for (u32 i = 0; i < count; ++i) { (*task)(data, i); }
+		return;
+	}
+
+	platform_start_job(task, data, count, helpers_count);
+	wait();
+}
+
+void run_async(task_func * task, void * data, u32 count) {
+	if (workers.is_job_running) { CUSTOM_ASSERT(false, "a job is running already"); wait(); }
+	if (count == 0) { return; }
+
+	// @Note: the calling thread is busy with its own work till `wait`
+	u32 helpers_count = (count < workers.count) ? count : workers.count;
+	if (helpers_count == 0) {
+		for (u32 i = 0; i < count; ++i) { (*task)(data, i); }
+		return;
+	}
+
+	platform_start_job(task, data, count, helpers_count);
+}
+
+void wait(void) {
+	if (!workers.is_job_running) { return; }
+	platform_do_job(workers.job);
+	WaitForSingleObject(workers.done_event, INFINITE);
+	workers.is_job_running = false;
+}
+
+Background_Task * start(task_func * task, void * data) {
+	Background_Task * background_task = (Background_Task *)calloc(1, sizeof(Background_Task));
+	background_task->task      = task;
+	background_task->data      = data;
+	background_task->count     = 1;
+	background_task->remaining = 1;
+	return platform_start_dedicated(background_task);
+}
+
+Background_Task * start_on_workers(task_func * task, void * data, u32 count) {
+	Background_Task * background_task = (Background_Task *)calloc(1, sizeof(Background_Task));
+	background_task->task      = task;
+	background_task->data      = data;
+	background_task->count     = count;
+	background_task->remaining = (LONG)count;
+	if (count == 0) { return background_task; }
+
+	// @Note: fall back to a dedicated thread
+	if (!workers.count || workers.queue_count == queue_limit) {
+		return platform_start_dedicated(background_task);
+	}
+
+	background_task->done_event = CreateEvent(NULL, TRUE, FALSE, NULL);
+	if (!background_task->done_event) {
+		LOG_LAST_ERROR();
+		return platform_start_dedicated(background_task);
+	}
+
+	EnterCriticalSection(&workers.queue_lock);
+	workers.queue[workers.queue_count++] = background_task;
+	LeaveCriticalSection(&workers.queue_lock);
+
+	u32 helpers_count = (count < workers.count) ? count : workers.count;
+	ReleaseSemaphore(workers.wake_semaphore, (LONG)helpers_count, NULL);
+	return background_task;
+}
+
+bool is_done(Background_Task * background_task) {
+	if (!background_task->handle) { return background_task->remaining == 0; }
+	return WaitForSingleObject(background_task->handle, 0) == WAIT_OBJECT_0;
+}
+
+void join(Background_Task * background_task) {
+	if (background_task->handle) {
+		WaitForSingleObject(background_task->handle, INFINITE);
+		CloseHandle(background_task->handle);
+	}
+	if (background_task->done_event) {
+		// @Note: help with the calls, which are yet to be claimed
+		while (platform_do_background_call(background_task)) { }
+		WaitForSingleObject(background_task->done_event, INFINITE);
+		CloseHandle(background_task->done_event);
+	}
+	free(background_task);
+}
+
+}}
+
+//
+// platform implementation
+//
+
+static void platform_start_job(custom::thread::task_func * task, void * data, u32 count, u32 helpers_count) {
+	// @Note: retire the previous claims first; a worker, which has read them already,
+	//        then fails to claim a task of the job, which is being set up
+	InterlockedExchange64(&workers.job.claims, ((LONG64)workers.generation << 32) | 0xffffffff);
+
+	workers.job.task      = task;
+	workers.job.data      = data;
+	workers.job.count     = count;
+	workers.job.remaining = (LONG)count;
+	workers.is_job_running = true;
+	MemoryBarrier();
+
+	// @Note: publishing a new generation comes last, so that the job is set up by then
+	++workers.generation;
+	InterlockedExchange64(&workers.job.claims, (LONG64)workers.generation << 32);
+	ReleaseSemaphore(workers.wake_semaphore, (LONG)helpers_count, NULL);
+}
+
+static void platform_do_job(Job & job) {
+	while (true) {
+		LONG64 claims = job.claims;
+		MemoryBarrier();
+		custom::thread::task_func * task = job.task;
+		void * data  = job.data;
+		u32    count = job.count;
+		MemoryBarrier();
+
+		u32 index = (u32)(claims & 0xffffffff);
+		if (index >= count) { break; }
+		if (InterlockedCompareExchange64(&job.claims, claims + 1, claims) != claims) { continue; }
+
+		(*task)(data, index);
+		if (InterlockedDecrement(&job.remaining) == 0) {
+			SetEvent(workers.done_event);
+		}
+	}
+}
+
+// @Note: claims a call of the first queued task, or of the `only` one, if it's provided
+static bool platform_do_background_call(custom::thread::Background_Task * only) {
+	custom::thread::Background_Task * background_task = NULL;
+	u32 index = 0;
+
+	EnterCriticalSection(&workers.queue_lock);
+	for (u32 i = 0; i < workers.queue_count; ++i) {
+		if (only && workers.queue[i] != only) { continue; }
+		background_task = workers.queue[i];
+		index = background_task->next++;
+		if (background_task->next == background_task->count) {
+			for (u32 j = i + 1; j < workers.queue_count; ++j) { workers.queue[j - 1] = workers.queue[j]; }
+			--workers.queue_count;
+		}
+		break;
+	}
+	LeaveCriticalSection(&workers.queue_lock);
+	if (!background_task) { return false; }
+
+	(*background_task->task)(background_task->data, index);
+	if (InterlockedDecrement(&background_task->remaining) == 0) {
+		SetEvent(background_task->done_event);
+	}
+	return true;
+}
+
+static custom::thread::Background_Task * platform_start_dedicated(custom::thread::Background_Task * background_task) {
+	background_task->handle = CreateThread(NULL, 0, platform_background_thread, background_task, 0, NULL);
+	if (!background_task->handle) {
+		// @Note: fall back to a synchronous call
+		LOG_LAST_ERROR();
+		platform_background_thread(background_task);
+	}
+	return background_task;
+}
+
+static DWORD WINAPI platform_worker_thread(LPVOID lpParam) {
+	(void)lpParam;
+	while (true) {
+		WaitForSingleObject(workers.wake_semaphore, INFINITE);
+		if (workers.should_quit) { break; }
+
+		// @Note: the main thread waits for the jobs, so they go first
+		//        and are checked anew after each background call
+		do {
+			platform_do_job(workers.job);
+		} while (platform_do_background_call(NULL));
+	}
+	return 0;
+}
+
+static DWORD WINAPI platform_background_thread(LPVOID lpParam) {
+	custom::thread::Background_Task * background_task = (custom::thread::Background_Task *)lpParam;
+	for (u32 i = 0; i < background_task->count; ++i) {
+		(*background_task->task)(background_task->data, i);
+	}
+	background_task->remaining = 0;
+	return 0;
+}
@@ -0,0 +1,27 @@
+project "engine_tests"
+	kind "ConsoleApp"
+	language "C++"
+	cdialect "C11"
+	cppdialect "C++17"
+	characterset ("ASCII") -- Default, Unicode, MBCS, ASCII
+
+	tests_to_root = path.getrelative(os.getcwd(), root_directory)
+	targetdir (tests_to_root .. "/" .. target_location .. "/%{prj.name}")
+	objdir (tests_to_root .. "/" .. intermediate_location .. "/%{prj.name}")
+	implibdir (tests_to_root .. "/" .. intermediate_location .. "/%{prj.name}")
+
+	debugdir ("%{cfg.targetdir}")
+
+	files {
+		"src/**.h",
+		"src/**.cpp",
+	}
+
+	includedirs {
+		tests_to_root .. "/custom_engine/%{engine_includes.custom_engine}",
+		tests_to_root .. "/custom_engine/%{engine_includes.lua}",
+	}
+
+	links {
+		"custom_engine",
+	}
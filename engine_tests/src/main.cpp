@@ -0,0 +1,552 @@
+#include "custom_engine.h"
+
+#include "engine/api/internal/component_types.h"
+#include "engine/api/internal/asset_types.h"
+#include "engine/api/internal/scene_streaming.h"
+#include "engine/api/internal/asset_pack.h"
+#include "engine/api/internal/parsing.h"
+#include "engine/api/platform/thread.h"
+#include "engine/core/lz4.h"
+#include "engine/impl/array.h"
+#include "engine/impl/reference.h"
+#include "engine/impl/entity_system.h"
+#include "engine/impl/asset_system.h"
+#include "engine/impl/math_linear.h"
+#include "engine/impl/math_hashing.h"
+#include "engine/impl/parsing.h"
+
+#include "engine/internal/asset_system/obj_parser.h"
+
+#if !defined(CUSTOM_PRECOMPILED_HEADER)
+	#include <stdio.h>
+	#include <string.h>
+#endif
+
+// @Note: runs engine checks, which need no window or graphics;
+//        prints the failed ones and returns their count
+
+void init_asset_types(void);
+void init_component_types(void);
+
+static u32 checks_count;
+static u32 failed_count;
+
+#define CHECK(condition) do {                                      \
+    ++checks_count;                                                \
+    if (condition) { break; }                                      \
+    printf("failed: %s, %s:%d\n", #condition, __FILE__, __LINE__); \
+    ++failed_count;                                                \
+} while (0)                                                        \
+
+//
+// deferred commands
+//
+
+static void test_commands_rem_then_add(void) {
+	custom::Entity entity = custom::Entity::create(true);
+	entity.add_component<Camera>();
+
+	entity.rem_component_deferred(custom::Component_Registry<Camera>::type);
+	entity.add_component_deferred(custom::Component_Registry<Camera>::type);
+	custom::Entity::apply_commands();
+	CHECK(entity.has_component<Camera>());
+
+	entity.add_component_deferred(custom::Component_Registry<Transform>::type);
+	entity.rem_component_deferred(custom::Component_Registry<Transform>::type);
+	custom::Entity::apply_commands();
+	CHECK(!entity.has_component<Transform>());
+
+	entity.destroy();
+}
+
+static void test_commands_add_then_copy(void) {
+	custom::Entity prefab = custom::Entity::create(false);
+	prefab.add_component<Camera>().get_fast()->ncp = 0.5f;
+
+	prefab.add_component_deferred(custom::Component_Registry<Transform>::type);
+	custom::Entity entity = prefab.copy_deferred(true);
+	prefab.rem_component_deferred(custom::Component_Registry<Camera>::type);
+	custom::Entity::apply_commands();
+
+	CHECK(entity.is_instance());
+	CHECK(entity.has_component<Transform>());
+	CHECK(entity.has_component<Camera>());
+	if (entity.has_component<Camera>()) {
+		CHECK(entity.get_component<Camera>().get_fast()->ncp == 0.5f);
+	}
+	CHECK(!prefab.has_component<Camera>());
+
+	entity.destroy();
+	prefab.destroy();
+}
+
+//
+// queries
+//
+
+static void test_query_matches(void) {
+	custom::Array<custom::Entity> entities;
+	for (u32 i = 0; i < 64; ++i) {
+		custom::Entity entity = custom::Entity::create(i % 16 != 0);
+		entity.add_component<Transform>().get_fast()->position.x = (r32)i;
+		if (i % 4 == 0) { entity.add_component<Camera>(); }
+		entities.push(entity);
+	}
+
+	// @Note: instances with a camera are 4, 8, 12, ..., but not 0, 16, 32, 48
+	u32 visited = 0; r32 sum = 0;
+	custom::Entity::query<Transform, Camera>([&](custom::Entity entity, Transform * transform, Camera * camera) {
+		CHECK(entity.is_instance());
+		CHECK(entity.get_component<Camera>().get_fast() == camera);
+		++visited; sum += transform->position.x;
+	});
+	CHECK(visited == 12);
+	CHECK(sum == 4 * (1+2+3 + 5+6+7 + 9+10+11 + 13+14+15));
+
+	u32 chunked = 0;
+	for (u32 chunk = 0; chunk < 3; ++chunk) {
+		custom::Entity::query_chunk<Camera, Transform>(chunk, 3, [&](custom::Entity, Camera *, Transform *) {
+			++chunked;
+		});
+	}
+	CHECK(chunked == visited);
+
+	for (u32 i = 0; i < entities.count; ++i) {
+		entities[i].destroy();
+	}
+}
+
+static void test_query_changed(void) {
+	custom::Entity first = custom::Entity::create(true);
+	custom::Entity second = custom::Entity::create(true);
+	first.add_component<Camera>();
+	second.add_component<Camera>();
+
+	u32 tick = ++custom::change_tick;
+	second.get_component<Camera>().touch();
+
+	u32 visited = 0;
+	custom::Entity::query_changed<Camera>(tick, [&](custom::Entity entity, Camera *) {
+		CHECK(entity == second);
+		++visited;
+	});
+	CHECK(visited == 1);
+
+	second.destroy();
+	first.destroy();
+}
+
+//
+// transforms
+//
+
+static bool is_close(vec3 first, vec3 second) {
+	vec3 delta = first - second;
+	return dot_product(delta, delta) < 0.0001f;
+}
+
+static void test_transform_cache_set_world(void) {
+	custom::Entity parent = custom::Entity::create(true);
+	Transform * parent_transform = parent.add_component<Transform>().get_fast();
+	parent_transform->position = {10, 0, 0};
+	parent_transform->scale    = {2, 2, 2};
+	parent_transform->rotation = quat_from_radians({0, 0, 1.5707963f});
+
+	custom::Entity child = custom::Entity::create(true);
+	child.add_component<Transform>().get_fast()->position = {1, 0, 0};
+	Hierarchy::set_parent(child, parent);
+
+	++custom::change_tick;
+	Transform_Cache::update();
+	CHECK(is_close(Transform_Cache::get_transform(child)->position, {10, 2, 0}));
+
+	Transform world = *Transform_Cache::get_transform(child);
+	world.position.x += 4;
+	Transform_Cache::set_transform(child, world);
+	CHECK(is_close(child.get_component<Transform>().get_fast()->position, {1, -2, 0}));
+
+	++custom::change_tick;
+	Transform_Cache::update();
+	CHECK(is_close(Transform_Cache::get_transform(child)->position, {14, 2, 0}));
+
+	child.destroy();
+	parent.destroy();
+}
+
+//
+// snapshots
+//
+
+static bool read_snapshot_into_world(custom::Bytecode const & bc) {
+	custom::Entity::State * world = custom::Entity::create_world();
+	custom::Entity::State * previous = custom::Entity::bind_world(world);
+	bc.read_offset = 0;
+	bool result = custom::Entity::read_snapshot(bc);
+	custom::Entity::bind_world(previous);
+	custom::Entity::destroy_world(world);
+	return result;
+}
+
+static void test_snapshot_corrupted(void) {
+	custom::Entity parent = custom::Entity::create(true);
+	parent.add_component<Transform>().get_fast()->position = {1, 2, 3};
+	custom::Entity child = custom::Entity::create(true);
+	child.add_component<Transform>();
+	child.add_component<Camera>();
+	Hierarchy::set_parent(child, parent);
+
+	custom::Bytecode bc;
+	custom::Entity::write_snapshot(bc);
+	child.destroy();
+	parent.destroy();
+
+	CHECK(read_snapshot_into_world(bc));
+
+	// @Note: every truncation should be rejected, not read past the buffer
+	u32 const count = bc.buffer.count;
+	bool any_truncated_read = false;
+	for (u32 i = 0; i < count; i += 4) {
+		bc.buffer.count = i;
+		any_truncated_read = any_truncated_read || read_snapshot_into_world(bc);
+	}
+	bc.buffer.count = count;
+	CHECK(!any_truncated_read);
+
+	// @Note: the word after the magic, version and the types' values count;
+	//        a huge count should be rejected, not allocated or read
+	u32 const values_count = *(u32 *)(bc.buffer.data + 2 * sizeof(u32));
+	u32 * types_count = (u32 *)(bc.buffer.data + 3 * sizeof(u32) + CUSTOM_ALIGN(values_count, sizeof(u32)));
+	u32 const saved = *types_count;
+	*types_count = 0xfffffff0;
+	CHECK(!read_snapshot_into_world(bc));
+	*types_count = saved;
+	CHECK(read_snapshot_into_world(bc));
+}
+
+//
+// meshes
+//
+
+template<typename T>
+static bool is_same(custom::Array<T> const & first, custom::Array<T> const & second) {
+	if (first.count != second.count) { return false; }
+	return memcmp(first.data, second.data, first.count * sizeof(T)) == 0;
+}
+
+static void test_obj_relative_indices(void) {
+	// @Note: relative indices point back across any chunk boundary
+	cstring source =
+		"v 0 0 0\n" "v 1 0 0\n" "v 0 1 0\n" "vt 0 0\n" "vt 1 0\n" "vt 0 1\n"
+		"f -3/-3 -2/-2 -1/-1\n"
+		"v 1 1 0\n" "vt 1 1\n"
+		"f -3/-3 -2/-2 -1/-1\n"
+		"f 1/1 -1/-1 3/3\n"
+		"v 2 0 0\n" "v 2 1 0\n" "vt 0.5 0\n" "vt 0.5 1\n"
+		"f -4/-4 -2/-2 -1/-1 -3/-3\n"
+		"f -6/-6 -5/-5 -4/-4\n";
+	custom::file::View file = {(u8 const *)source, (u64)strlen(source)};
+
+	custom::Array<u8> expected_attributes; custom::Array<r32> expected_vertices; custom::Array<u32> expected_indices;
+	custom::obj::parse_chunks(file, 1, expected_attributes, expected_vertices, expected_indices);
+	CHECK(expected_indices.count == 6 * 3);
+
+	for (u32 chunks_count = 2; chunks_count <= 8; ++chunks_count) {
+		custom::Array<u8> attributes; custom::Array<r32> vertices; custom::Array<u32> indices;
+		custom::obj::parse_chunks(file, chunks_count, attributes, vertices, indices);
+		CHECK(is_same(attributes, expected_attributes));
+		CHECK(is_same(vertices, expected_vertices));
+		CHECK(is_same(indices, expected_indices));
+	}
+}
+
+static u32 triangle_elements;
+static int compare_triangles(void const * a, void const * b) {
+	return memcmp(a, b, triangle_elements * sizeof(r32));
+}
+
+// @Note: unpacks triangles into vertex tuples and sorts them, so that
+//        meshes might be compared regardless of vertex and triangle order
+template<typename Index>
+static void get_sorted_triangles(r32 const * vertices, u32 elements_per_vertex, Index const * indices, u32 indices_count, custom::Array<r32> & out) {
+	out.count = 0;
+	out.ensure_capacity(indices_count * elements_per_vertex);
+	for (u32 i = 0; i < indices_count; ++i) {
+		out.push_range(vertices + indices[i] * elements_per_vertex, elements_per_vertex);
+	}
+	triangle_elements = 3 * elements_per_vertex;
+	qsort(out.data, indices_count / 3, triangle_elements * sizeof(r32), &compare_triangles);
+}
+
+static void test_mesh_optimization(void) {
+	// @Note: a grid, which quads are listed out of order, plus an unused vertex
+	u32 const size = 16;
+	custom::Array<char> source;
+	char line[64];
+	for (u32 y = 0; y <= size; ++y) {
+		for (u32 x = 0; x <= size; ++x) {
+			int length = snprintf(line, sizeof(line), "v %u %u 0\nvt %u %u\n", x, y, x, y);
+			source.push_range(line, (u32)length);
+		}
+	}
+	cstring const unused_vertex = "v 9 9 9\nvt 9 9\n";
+	source.push_range(unused_vertex, (u32)strlen(unused_vertex));
+	for (u32 i = 0; i < size * size; ++i) {
+		u32 quad = (i * 7) % (size * size);
+		u32 corner = (quad / size) * (size + 1) + (quad % size) + 1;
+		int length = snprintf(line, sizeof(line), "f %u/%u %u/%u %u/%u %u/%u\n",
+			corner, corner, corner + 1, corner + 1,
+			corner + size + 2, corner + size + 2, corner + size + 1, corner + size + 1
+		);
+		source.push_range(line, (u32)length);
+	}
+	source.push('\0'); --source.count;
+	custom::file::View file = {(u8 const *)source.data, source.count};
+
+	custom::Array<u8> attributes; custom::Array<r32> vertices; custom::Array<u32> indices;
+	custom::obj::parse(file, attributes, vertices, indices);
+	CHECK(attributes.count == 2 && indices.count == size * size * 6);
+	if (attributes.count != 2) { return; }
+	u32 const elements_per_vertex = attributes[0] + attributes[1];
+	custom::Array<r32> expected;
+	get_sorted_triangles(vertices.data, elements_per_vertex, indices.data, indices.count, expected);
+
+	custom::Mesh_Asset asset = {};
+	asset.update(file);
+	CHECK(asset.buffers.count == 2);
+	if (asset.buffers.count != 2) { return; }
+
+	custom::Mesh_Asset::Buffer const & vertex_buffer = asset.buffers[0];
+	custom::Mesh_Asset::Buffer const & index_buffer  = asset.buffers[1];
+	CHECK(index_buffer.is_index && index_buffer.data_type == custom::graphics::Data_Type::u16);
+	CHECK(vertex_buffer.buffer.count == (size + 1) * (size + 1) * elements_per_vertex * sizeof(r32));
+	CHECK(index_buffer.buffer.count == indices.count * sizeof(u16));
+
+	custom::Array<r32> optimized;
+	get_sorted_triangles(
+		(r32 const *)vertex_buffer.buffer.data, elements_per_vertex,
+		(u16 const *)index_buffer.buffer.data, index_buffer.buffer.count / sizeof(u16), optimized
+	);
+	CHECK(is_same(optimized, expected));
+}
+
+//
+// compression
+//
+
+static u32 random_state = 2463534242U;
+static u8 random_byte(void) {
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return (u8)random_state;
+}
+
+static bool lz4_round_trip(u8 const * data, u32 count) {
+	custom::Array<u8> packed(custom::lz4::get_bound(count));
+	packed.count = custom::lz4::compress(data, count, packed.data);
+	if (packed.count > custom::lz4::get_bound(count)) { return false; }
+
+	custom::Array<u8> unpacked(count + 1);
+	if (!custom::lz4::decompress(packed.data, packed.count, unpacked.data, count)) { return false; }
+	return memcmp(unpacked.data, data, count) == 0;
+}
+
+static void test_lz4(void) {
+	u32 const count = 4096;
+	u8 noise[count], runs[count], pattern[count];
+	for (u32 i = 0; i < count; ++i) {
+		noise[i]   = random_byte();
+		runs[i]    = (i < 1000) ? 'a' : (i < 1400) ? random_byte() : 'b';
+		pattern[i] = "abc"[i % 3];
+	}
+
+	// @Note: incompressible data, long literals and overlapping matches, runs past 255
+	CHECK(lz4_round_trip(noise, count));
+	CHECK(lz4_round_trip(runs, count));
+	CHECK(lz4_round_trip(pattern, count));
+
+	// @Note: blocks around the minimum one, which might hold a match
+	u32 const small_counts[] = {0, 1, 12, 13};
+	for (u32 i = 0; i < C_ARRAY_LENGTH(small_counts); ++i) {
+		CHECK(lz4_round_trip(noise, small_counts[i]));
+		CHECK(lz4_round_trip(pattern, small_counts[i]));
+	}
+
+	// @Note: truncated input or a wrong output size should be rejected
+	custom::Array<u8> packed(custom::lz4::get_bound(count));
+	packed.count = custom::lz4::compress(runs, count, packed.data);
+	CHECK(packed.count < count / 4);
+	custom::Array<u8> unpacked(count);
+	bool any_truncated_decompressed = false;
+	for (u32 i = 0; i < packed.count; ++i) {
+		any_truncated_decompressed = any_truncated_decompressed || custom::lz4::decompress(packed.data, i, unpacked.data, count);
+	}
+	CHECK(!any_truncated_decompressed);
+	CHECK(!custom::lz4::decompress(packed.data, packed.count, unpacked.data, count - 1));
+	CHECK(!custom::lz4::decompress(packed.data, packed.count, unpacked.data, count + 1));
+}
+
+// @Note: writes the layout `asset_cooker` does, see `pack::Header`
+static void test_pack(void) {
+	// @Note: the first two paths' hashes collide
+	cstring const paths[] = {
+		"assets/textures/952929.png",
+		"assets/textures/1008296.png",
+		"assets/configs/client.cfg",
+	};
+	CHECK(custom::pack::hash_path(paths[0]) == custom::pack::hash_path(paths[1]));
+
+	u8 stored[100], repetitive[1000];
+	for (u32 i = 0; i < sizeof(stored); ++i)     { stored[i] = random_byte() | 1; }
+	for (u32 i = 0; i < sizeof(repetitive); ++i) { repetitive[i] = (u8)('a' + i % 7); }
+
+	custom::Array<u8> packed(custom::lz4::get_bound(sizeof(repetitive)));
+	packed.count = custom::lz4::compress(repetitive, sizeof(repetitive), packed.data);
+
+	custom::Array<char> paths_block;
+	for (u32 i = 0; i < C_ARRAY_LENGTH(paths); ++i) {
+		paths_block.push_range(paths[i], (u32)strlen(paths[i]) + 1);
+	}
+
+	// @Note: entries are sorted by hashes; the colliding ones end up adjacent,
+	//        so finding the compressed entry means skipping the stored one
+	custom::pack::Entry entries[3];
+	entries[0] = {custom::pack::hash_path(paths[0]), 0, 0, sizeof(stored), sizeof(stored)};
+	entries[1] = {custom::pack::hash_path(paths[1]), (u32)strlen(paths[0]) + 1, 0, sizeof(repetitive), packed.count};
+	entries[2] = {custom::pack::hash_path(paths[2]), (u32)(strlen(paths[0]) + strlen(paths[1]) + 2), 0, sizeof(stored), sizeof(stored)};
+	if (entries[2].hash < entries[0].hash) {
+		custom::pack::Entry first = entries[2];
+		entries[2] = entries[1]; entries[1] = entries[0]; entries[0] = first;
+	}
+
+	custom::pack::Header header = {custom::pack::magic, custom::pack::version, 3, paths_block.count};
+	custom::Array<u8> file;
+	file.push_range((u8 const *)&header, sizeof(header));
+	u32 entries_offset = file.count;
+	file.push_range((u8 const *)entries, sizeof(entries));
+	file.push_range((u8 const *)paths_block.data, paths_block.count);
+	for (u32 i = 0; i < C_ARRAY_LENGTH(entries); ++i) {
+		while (file.count % custom::pack::alignment) { file.push(0); }
+		entries[i].offset = file.count;
+		bool is_stored = (entries[i].count == entries[i].packed_count);
+		if (is_stored) { file.push_range(stored, sizeof(stored)); file.push(0); }
+		else { file.push_range(packed.data, packed.count); }
+	}
+	memcpy(file.data + entries_offset, entries, sizeof(entries));
+
+	cstring path = "engine_tests_assets.pack";
+	FILE * pack = fopen(path, "wb");
+	CHECK(pack);
+	if (!pack) { return; }
+	fwrite(file.data, 1, file.count, pack);
+	fclose(pack);
+
+	CHECK(custom::pack::mount(path));
+	custom::file::View view;
+	custom::Array<u8> buffer;
+
+	CHECK(custom::pack::read(paths[0], view, buffer));
+	CHECK(view.count == sizeof(stored) && memcmp(view.data, stored, sizeof(stored)) == 0);
+	CHECK(view.data != buffer.data && view.data[view.count] == 0);
+
+	CHECK(custom::pack::read(paths[1], view, buffer));
+	CHECK(view.count == sizeof(repetitive) && memcmp(view.data, repetitive, sizeof(repetitive)) == 0);
+	CHECK(view.data == buffer.data && view.data[view.count] == 0);
+
+	CHECK(custom::pack::read(paths[2], view, buffer));
+	CHECK(!custom::pack::read("assets/textures/missing.png", view, buffer));
+
+	custom::pack::unmount();
+	remove(path);
+}
+
+//
+// scene streaming
+//
+
+static void test_streaming_instances(void) {
+	cstring path = "engine_tests_scene.prefab";
+	FILE * file = fopen(path, "wb");
+	CHECK(file);
+	if (!file) { return; }
+	fputs(
+		"> # child\n"
+		"\t! Transform\n"
+		"\t\t\tposition 1 2 3\n"
+		"\t~ # stop parsing inlined prefab\n",
+		file
+	);
+	fclose(file);
+
+	custom::Ref scene = custom::streaming::load(path);
+	while (!custom::streaming::is_loaded(scene)) {
+		custom::streaming::update();
+	}
+	remove(path);
+
+	custom::Entity root = custom::streaming::get_root(scene);
+	CHECK(root.exists() && root.is_instance());
+
+	u32 visited = 0;
+	custom::Entity::query<Transform>([&](custom::Entity entity, Transform * transform) {
+		CHECK(transform->position.z == 3);
+		++visited;
+	});
+	CHECK(visited == 1);
+
+	custom::streaming::unload(scene);
+	while (root.exists()) {
+		custom::streaming::update();
+	}
+	custom::streaming::shutdown();
+}
+
+//
+// asynchronous loading
+//
+
+static void test_async_failed_decode(void) {
+	cstring path = "engine_tests_texture.png";
+	FILE * file = fopen(path, "wb");
+	CHECK(file);
+	if (!file) { return; }
+	fputs("not an image", file);
+	fclose(file);
+
+	u32 resource = custom::Asset::store_string(path, custom::empty_index);
+	custom::Asset_RefT<custom::Texture_Asset> texture = custom::Asset::add_async<custom::Texture_Asset>(resource);
+	CHECK(texture.is_pending());
+
+	custom::Asset::wait_async();
+	remove(path);
+
+	CHECK(!texture.is_pending());
+	CHECK(texture.is_failed());
+	CHECK(!texture.ref.get_fast()->data.data);
+
+	// @Note: there's no loader bytecode, so unloading would crash
+	texture.destroy();
+}
+
+int main(int argc, char * argv[]) {
+	init_asset_types();
+	init_component_types();
+
+	test_commands_rem_then_add();
+	test_commands_add_then_copy();
+	test_query_matches();
+	test_query_changed();
+	test_transform_cache_set_world();
+	test_snapshot_corrupted();
+	test_obj_relative_indices();
+	test_mesh_optimization();
+	test_lz4();
+	test_pack();
+	test_streaming_instances();
+	test_async_failed_decode();
+
+	custom::Entity::reset_system();
+
+	printf("---- ENGINE TESTS: %u checks, %u failed ----\n", checks_count, failed_count);
+	return failed_count ? 1 : 0;
+}
@@ -30,4 +30,8 @@ set flags=/Q /Y /S /I /D
 xcopy %flags% "./custom_engine/assets" "./bin/%target_location%/sandbox/assets"
 xcopy %flags% "./sandbox/assets" "./bin/%target_location%/sandbox/assets"
 
+rem cooked files are newer than the sources, so xcopy skips them afterwards
+set cooker="./bin/%target_location%/asset_cooker/asset_cooker.exe"
+if exist %cooker% %cooker% "./bin/%target_location%/sandbox/assets"
+
 echo ---- PREPARE ASSETS: DONE  ---- %time%
@@ -0,0 +1,19 @@
+local lua_tag = "\x1b[38;5;202m" .. "[lua]" .. "\x1b[0m" .. " "
+
+local scene = nil
+
+function global_init_streaming_test()
+	-- camera to debug the scene
+	Asset.add(Prefab_Asset.type, "assets/prefabs/camera flying.prefab")
+
+	-- read and instantiate in the background, merged at a frame boundary
+	scene = Scene.load("assets/prefabs/- scene - prefabs test.prefab")
+end
+
+function global_update_streaming_test()
+	if scene ~= nil and scene:is_loaded() then
+		local root = scene:get_root()
+		print(lua_tag .. "global_update_streaming_test (scene is loaded, root exists: " .. tostring(root ~= nil) .. ")")
+		scene = nil
+	end
+end
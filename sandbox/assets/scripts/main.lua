@@ -10,6 +10,9 @@ local function local_init()
 	
 	-- Asset.add(Lua_Asset.type, "assets/scripts/- scene - prefabs test.lua")
 	-- global_init_prefab_test()
+	
+	-- Asset.add(Lua_Asset.type, "assets/scripts/- scene - streaming test.lua")
+	-- global_init_streaming_test()
 end
 
 -- executed on load
@@ -23,6 +26,7 @@ end
 function global_update()
 	-- global_update_physics_test()
 	-- global_update_prefab_test()
+	-- global_update_streaming_test()
 	
 	if Input.get_key(Key_Code.Shift) and Input.get_key(Key_Code.F5) then
 		local_init()
@@ -34,6 +34,18 @@ project "sandbox"
 		"custom_engine",
 	}
 
+	dependson {
+		"asset_cooker",
+	}
+
 	postbuildcommands {
-		("xcopy /Q /Y /S /I /D \"%{prj.location}assets\" \"%{cfg.buildtarget.directory}assets\"")
+		("xcopy /Q /Y /S /I /D \"%{prj.location}assets\" \"%{cfg.buildtarget.directory}assets\""),
+		-- @Note: xcopy skips cooked files, as they are newer than the sources
+		("\"%{cfg.buildtarget.directory}../asset_cooker/asset_cooker.exe\" \"%{cfg.buildtarget.directory}assets\""),
 	}
+
+	-- @Note: shipping builds load assets from a single pack file, if it's there
+	filter "configurations:Shipping"
+		postbuildcommands {
+			("\"%{cfg.buildtarget.directory}../asset_cooker/asset_cooker.exe\" \"%{cfg.buildtarget.directory}assets\" \"%{cfg.buildtarget.directory}assets.pack\""),
+		}
@@ -1,12 +1,18 @@
+#include "custom_pch.h"
+
+#include "engine/core/code.h"
+#include "engine/debug/log.h"
+#include "engine/impl/array.h"
+
 #include "asset_types.h"
 
 //
 // Shader_Asset
 //
 
-void Lua_Asset::update(custom::Array<u8> & file) {
-	// file.push('\0'); --file.count;
-	source.data     = file.data;     file.data     = NULL;
-	source.capacity = file.capacity; file.capacity = 0;
-	source.count    = file.count;    file.count    = 0;
+void Lua_Asset::update(custom::file::View file) {
+	if (file.count >= UINT32_MAX) { CUSTOM_ASSERT(false, "script is too large"); return; }
+	source.set_capacity((u32)file.count);
+	source.count = 0;
+	source.push_range(file.data, (u32)file.count);
 }
@@ -1,11 +1,12 @@
 #pragma once
 #include "engine/core/types.h"
 #include "engine/core/collection_types.h"
+#include "engine/api/platform/file.h"
 
 struct Lua_Asset {
 	custom::Array<u8> source;
 
-	void update(custom::Array<u8> & file);
+	void update(custom::file::View file);
 
 	~Lua_Asset() = default;
 };
@@ -14,12 +14,17 @@ template struct custom::Asset_RefT<T>; \
 
 #include "../registry_impl/asset_types.h"
 
+#if defined(REF_POOL_PAGED)
+#define ASSET_IMPL(T) template struct custom::Array_Paged<T>;
+#include "../registry_impl/asset_types.h"
+#endif
+
 namespace custom {
 
-#define ASSET_IMPL(T)                                                               \
-static REF_VOID_FUNC(ref_pool_create_##T) { return RefT<T>::pool.create(); }        \
-static VOID_REF_FUNC(ref_pool_destroy_##T) { RefT<T>::pool.destroy(ref); }          \
-static BOOL_REF_FUNC(ref_pool_contains_##T) { return RefT<T>::pool.contains(ref); } \
+#define ASSET_IMPL(T)                                                                     \
+static REF_VOID_FUNC(ref_pool_create_##T) { return RefT<T>::get_pool().create(); }        \
+static VOID_REF_FUNC(ref_pool_destroy_##T) { RefT<T>::get_pool().destroy(ref); }          \
+static BOOL_REF_FUNC(ref_pool_contains_##T) { return RefT<T>::get_pool().contains(ref); } \
 
 #include "../registry_impl/asset_types.h"
 
@@ -51,6 +56,8 @@ void init_client_asset_types(void) {
 	custom::Asset::vtable.load.set_capacity(custom::asset_names.get_count());
 	custom::Asset::vtable.unload.set_capacity(custom::asset_names.get_count());
 	custom::Asset::vtable.update.set_capacity(custom::asset_names.get_count());
+	custom::Asset::vtable.decode.set_capacity(custom::asset_names.get_count());
+	custom::Asset::vtable.apply.set_capacity(custom::asset_names.get_count());
 
 	#define ASSET_IMPL(T)                                                       \
 	custom::Asset::vtable.create.push(&custom::ref_pool_create_##T);            \
@@ -59,6 +66,8 @@ void init_client_asset_types(void) {
 	custom::Asset::vtable.load.push(&custom::loading::asset_pool_load_##T);     \
 	custom::Asset::vtable.unload.push(&custom::loading::asset_pool_unload_##T); \
 	custom::Asset::vtable.update.push(&custom::loading::asset_pool_update_##T); \
+	custom::Asset::vtable.decode.push(NULL);                                    \
+	custom::Asset::vtable.apply.push(NULL);                                     \
 
 	#include "../registry_impl/asset_types.h"
 }
@@ -2,6 +2,7 @@
 #include "engine/core/collection_types.h"
 #include "engine/debug/log.h"
 #include "engine/api/platform/file.h"
+#include "engine/api/internal/asset_pack.h"
 #include "engine/impl/array.h"
 #include "engine/impl/asset_system.h"
 
@@ -13,12 +14,35 @@
 
 namespace custom {
 
+// @Note: contents of an asset file: a view into the pack, a mapped loose file, or
+//        `buffer`, if the mapping lacks a terminating zero; see `file::map`
+struct Asset_File {
+	file::View view;
+	Array<u8>  buffer;
+	b8         is_mapped;
+
+	~Asset_File(void) {
+		if (is_mapped) { file::unmap(view); }
+	}
+};
+
 // @Todo: revisit
-static void read_file_safely(cstring path, Array<u8> & buffer) {
+static void read_file_safely(cstring path, Asset_File & asset_file) {
+	if (pack::read(path, asset_file.view, asset_file.buffer)) { return; }
+
 	constexpr u32 count = 4;
 	if (!file::get_time(path)) { CUSTOM_ASSERT(false, "file doesn't exist '%s'", path); return; }
+
+	if (file::map(path, asset_file.view)) {
+		if (asset_file.view.count % file::get_page_size()) { asset_file.is_mapped = true; return; }
+		file::unmap(asset_file.view);
+	}
+
 	for (u32 i = 0; i < count; ++i) {
-		if (file::read(path, buffer)) { return; }
+		if (!file::read(path, asset_file.buffer)) { continue; }
+		asset_file.buffer.push('\0'); --asset_file.buffer.count;
+		asset_file.view = {asset_file.buffer.data, asset_file.buffer.count};
+		return;
 	}
 	CUSTOM_ASSERT(false, "failed to read file safely: '%s'", path);
 }
@@ -58,11 +82,14 @@ LOADING_FUNC(asset_pool_load_Lua_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Lua_Asset * asset = refT.get_fast();
-	asset->update(file);
+	asset->source.data     = NULL;
+	asset->source.capacity = 0;
+	asset->source.count    = 0;
+	asset->update(file.view);
 
 	// @Note: direct the asset to Lua
 	if (CUSTOM_LOAD() != LUA_OK) {
@@ -98,11 +125,11 @@ LOADING_FUNC(asset_pool_update_Lua_Asset) {
 
 	//
 	cstring path = asset_ref.get_path();
-	Array<u8> file; read_file_safely(path, file);
-	if (!file.count) { return; }
+	Asset_File file = {}; read_file_safely(path, file);
+	if (!file.view.count) { return; }
 
 	Lua_Asset * asset = refT.get_fast();
-	asset->update(file);
+	asset->update(file.view);
 
 	// @Note: direct the asset to Lua
 	if (CUSTOM_LOAD() != LUA_OK) {
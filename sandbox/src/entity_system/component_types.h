@@ -24,10 +24,8 @@ struct Visual
 	u8 layer = 0;
 };
 
-struct Physical
-{
-	u8 dummy;
-};
+// @Note: a tag; see `TAG_IMPL`
+struct Physical {};
 
 struct Phys2d
 {
@@ -16,7 +16,13 @@ ENTITY_FROM_TO_FUNC(component_pool_copy_Visual) {
 	RefT<Visual> const & fromT = (RefT<Visual> const &)from;
 	RefT<Visual> & toT = (RefT<Visual> &)to;
 
-	*toT.get_fast() = *fromT.get_fast();
+	Visual const * source = fromT.get_fast();
+	Visual * component = toT.get_fast();
+
+	component->shader.assign(source->shader);
+	component->texture.assign(source->texture);
+	component->mesh.assign(source->mesh);
+	component->layer = source->layer;
 }
 
 ENTITY_LOADING_FUNC(component_pool_load_Visual) {
@@ -29,8 +35,12 @@ ENTITY_LOADING_FUNC(component_pool_load_Visual) {
 }
 
 ENTITY_LOADING_FUNC(component_pool_unload_Visual) {
-	// RefT<Visual> & refT = (RefT<Visual> &)ref;
-	// Visual * component = refT.get_fast();
+	RefT<Visual> & refT = (RefT<Visual> &)ref;
+	Visual * component = refT.get_fast();
+
+	component->shader.release();
+	component->texture.release();
+	component->mesh.release();
 }
 
 }
@@ -62,29 +72,6 @@ ENTITY_LOADING_FUNC(component_pool_unload_Lua_Script) {
 
 }
 
-//
-// Physical
-//
-
-namespace custom {
-
-ENTITY_FROM_TO_FUNC(component_pool_copy_Physical) {
-	RefT<Physical> const & fromT = (RefT<Physical> const &)from;
-	RefT<Physical> & toT = (RefT<Physical> &)to;
-
-	*toT.get_fast() = *fromT.get_fast();
-}
-
-ENTITY_LOADING_FUNC(component_pool_load_Physical) {
-	// RefT<Physical> & refT = (RefT<Physical> &)ref;
-}
-
-ENTITY_LOADING_FUNC(component_pool_unload_Physical) {
-	// RefT<Physical> & refT = (RefT<Physical> &)ref;
-}
-
-}
-
 //
 // Phys2d
 //
@@ -95,6 +82,9 @@ ENTITY_FROM_TO_FUNC(component_pool_copy_Phys2d) {
 	RefT<Phys2d> const & fromT = (RefT<Phys2d> const &)from;
 	RefT<Phys2d> & toT = (RefT<Phys2d> &)to;
 
+	// @Note: keeps the asset references count
+	fromT.get_fast()->mesh.acquire();
+	toT.get_fast()->mesh.release();
 	*toT.get_fast() = *fromT.get_fast();
 }
 
@@ -122,8 +112,10 @@ ENTITY_LOADING_FUNC(component_pool_load_Phys2d) {
 }
 
 ENTITY_LOADING_FUNC(component_pool_unload_Phys2d) {
-	// RefT<Phys2d> & refT = (RefT<Phys2d> &)ref;
-	// Phys2d * component = refT.get_fast();
+	RefT<Phys2d> & refT = (RefT<Phys2d> &)ref;
+	Phys2d * component = refT.get_fast();
+
+	component->mesh.release();
 }
 
 }
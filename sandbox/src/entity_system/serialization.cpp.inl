@@ -43,21 +43,21 @@ READ_FUNC(component_pool_read_Visual) {
 		if (key_id == key_shader) {
 			u32 path_length = to_string_length(source);
 			u32 path_id     = Asset::store_string(*source, path_length);
-			component->shader = Asset::add<Shader_Asset>(path_id);
+			component->shader.assign(Asset::add<Shader_Asset>(path_id));
 			continue;
 		}
 
 		if (key_id == key_texture) {
 			u32 path_length = to_string_length(source);
 			u32 path_id     = Asset::store_string(*source, path_length);
-			component->texture = Asset::add<Texture_Asset>(path_id);
+			component->texture.assign(Asset::add<Texture_Asset>(path_id));
 			continue;
 		}
 
 		if (key_id == key_mesh) {
 			u32 path_length = to_string_length(source);
 			u32 path_id     = Asset::store_string(*source, path_length);
-			component->mesh = Asset::add<Mesh_Asset>(path_id);
+			component->mesh.assign(Asset::add<Mesh_Asset>(path_id));
 			continue;
 		}
 
@@ -67,6 +67,26 @@ READ_FUNC(component_pool_read_Visual) {
 	}
 }
 
+SNAPSHOT_REMAP_FUNC(component_pool_remap_Visual) {
+	RefT<Visual> & refT = (RefT<Visual> &)ref;
+	Visual * component = refT.get_fast();
+
+	// @Note: assets are resolved by path, so they get loaded if need be;
+	//        asynchronously, as merging a streamed scene mustn't stall the frame;
+	//        previous refs aren't counted, being either staged or snapshotted
+	u32 shader_id  = remap.get_asset_string(component->shader.resource);
+	u32 texture_id = remap.get_asset_string(component->texture.resource);
+	u32 mesh_id    = remap.get_asset_string(component->mesh.resource);
+
+	component->shader  = {custom::empty_ref, custom::empty_index};
+	component->texture = {custom::empty_ref, custom::empty_index};
+	component->mesh    = {custom::empty_ref, custom::empty_index};
+
+	if (shader_id  != custom::empty_index) { component->shader.assign(Asset::add_async<Shader_Asset>(shader_id)); }
+	if (texture_id != custom::empty_index) { component->texture.assign(Asset::add_async<Texture_Asset>(texture_id)); }
+	if (mesh_id    != custom::empty_index) { component->mesh.assign(Asset::add_async<Mesh_Asset>(mesh_id)); }
+}
+
 }}
 
 //
@@ -113,34 +133,11 @@ READ_FUNC(component_pool_read_Lua_Script) {
 	}
 }
 
-}}
-
-//
-// Physical
-//
-
-namespace custom {
-namespace serialization {
-
-READ_FUNC(component_pool_read_Physical) {
-	RefT<Physical> & refT = (RefT<Physical> &)ref;
-
-	Physical * component = refT.get_fast();
-
-	CUSTOM_ASSERT(strncmp_auto(*source, "Physical") == 0, "");
-	while ((to_next_line(source), **source)) {
-
-		parse_void(source);
-		if (**source == '#') { continue; }
-		if (!IS_VALID_IDENTIFIER_START(**source)) { break; }
-
-		u32 key_length = to_identifier_length(source);
-		cstring key    = *source; skip_to_void(source);
-		u32 key_id     = Entity::get_id(key, key_length);
-		if (key_id == custom::empty_index) { *source = key; break; }
+SNAPSHOT_REMAP_FUNC(component_pool_remap_Lua_Script) {
+	RefT<Lua_Script> & refT = (RefT<Lua_Script> &)ref;
+	Lua_Script * component = refT.get_fast();
 
-		*source = key; break;
-	}
+	component->update_string_id = remap.get_entity_string(component->update_string_id);
 }
 
 }}
@@ -191,7 +188,7 @@ READ_FUNC(component_pool_read_Phys2d) {
 		if (key_id == key_collider) {
 			u32 path_length = to_string_length(source);
 			u32 path_id     = Asset::store_string(*source, path_length);
-			component->mesh = Asset::add<Collider2d_Asset>(path_id);
+			component->mesh.assign(Asset::add<Collider2d_Asset>(path_id));
 			continue;
 		}
 
@@ -199,4 +196,18 @@ READ_FUNC(component_pool_read_Phys2d) {
 	}
 }
 
+SNAPSHOT_REMAP_FUNC(component_pool_remap_Phys2d) {
+	RefT<Phys2d> & refT = (RefT<Phys2d> &)ref;
+	Phys2d * component = refT.get_fast();
+
+	// @Note: assets are resolved by path, so they get loaded if need be;
+	//        asynchronously, same as for `Visual`; physics skips a body
+	//        until its collider has been loaded
+	u32 mesh_id = remap.get_asset_string(component->mesh.resource);
+
+	component->mesh = {custom::empty_ref, custom::empty_index};
+
+	if (mesh_id != custom::empty_index) { component->mesh.assign(Asset::add_async<Collider2d_Asset>(mesh_id)); }
+}
+
 }}
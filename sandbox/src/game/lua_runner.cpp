@@ -3,6 +3,7 @@
 #include "engine/debug/log.h"
 #include "engine/api/internal/entity_system.h"
 #include "engine/impl/array.h"
+#include "engine/impl/entity_system.h"
 
 #include "../entity_system/component_types.h"
 
@@ -59,15 +60,9 @@ static void lua_function(lua_State * L, cstring name, custom::Entity const & ent
 
 void ecs_update_lua(lua_State * L, r32 dt) {
 	custom::Array<Script_Blob> scripts(8);
-	for (u32 i = 0; i < custom::Entity::state.instances.count; ++i) {
-		custom::Entity entity = custom::Entity::state.instances[i];
-		if (!entity.exists()) { continue; }
-
-		Lua_Script const * script = entity.get_component<Lua_Script>().get_safe();
-		if (!script) { continue; }
-
+	custom::Entity::query<Lua_Script>([&](custom::Entity entity, Lua_Script const * script) {
 		scripts.push({entity, script});
-	}
+	});
 
 	for (u32 i = 0; i < scripts.count; ++i) {
 		if (scripts[i].script->update_string_id == custom::empty_index) { continue; }
@@ -4,6 +4,7 @@
 #include "engine/api/internal/asset_types.h"
 #include "engine/impl/array.h"
 #include "engine/impl/reference.h"
+#include "engine/impl/entity_system.h"
 #include "engine/impl/math_linear.h"
 
 #include "../entity_system/component_types.h"
@@ -18,8 +19,10 @@ struct Physics_Settings {
 }
 
 static Physics_Settings settings;
+static r32 elapsed     = 0;
+static u32 steps_count = 0;
 
-static void ecs_update_physics_iteration(r32 dt);
+static void ecs_update_physics_iteration(r32 dt, Phys2d * physical, Transform & world);
 
 //
 //
@@ -30,7 +33,7 @@ namespace sandbox {
 static custom::Asset_RefT<custom::Config_Asset> config_ref = {custom::empty_ref, custom::empty_index};
 void ecs_init_physics_clean(void) {
 	u32 config_id = custom::Asset::get_id("assets/configs/client.cfg", custom::empty_index);
-	config_ref = custom::Asset::add<custom::Config_Asset>(config_id);
+	config_ref.assign(custom::Asset::add<custom::Config_Asset>(config_id));
 }
 
 static void consume_config(void) {
@@ -49,18 +52,45 @@ static void consume_config(void) {
 	};
 }
 
-void ecs_update_physics_clean(r32 dt) {
+// @Note: chunks share the fixed steps count, so it's counted beforehand
+void ecs_prepare_physics_clean(r32 dt) {
 	consume_config();
 
 	CUSTOM_ASSERT(settings.frequency, "zero frequency");
 	r32 period = 1.0f / settings.frequency;
 
 	//
-	static r32 elapsed = 0; elapsed += dt;
+	elapsed += dt;
+	steps_count = 0;
 	while (elapsed >= period) {
 		elapsed -= period;
-		ecs_update_physics_iteration(period);
+		++steps_count;
 	}
+
+	// @Note: bodies are simulated in world space, whatever their hierarchy is;
+	//        chunks only read the cache, so it's brought up to date beforehand
+	if (steps_count) { Transform_Cache::update(); }
+}
+
+// @Note: bodies don't interact yet, so any part of them might be processed apart
+void ecs_update_physics_clean(u32 chunk, u32 chunks_count) {
+	if (!steps_count) { return; }
+	r32 period = 1.0f / settings.frequency;
+
+	custom::Entity::query_chunk<Transform, Phys2d>(chunk, chunks_count, [&](custom::Entity entity, Transform *, Phys2d * physical) {
+		// @Note: keep static bodies' change versions intact
+		if (!physical->movable) { return; }
+		entity.get_component<Phys2d>().touch();
+
+		Transform world = *Transform_Cache::get_transform(entity);
+		Transform const before = world;
+		for (u32 i = 0; i < steps_count; ++i) {
+			ecs_update_physics_iteration(period, physical, world);
+		}
+		// @Note: resting bodies keep their transforms' change versions intact
+		if (memcmp(&world, &before, sizeof(world)) == 0) { return; }
+		Transform_Cache::set_transform(entity, world);
+	});
 }
 
 }
@@ -69,6 +99,6 @@ void ecs_update_physics_clean(r32 dt) {
 //
 //
 
-static void ecs_update_physics_iteration(r32 dt) {
+static void ecs_update_physics_iteration(r32 dt, Phys2d * physical, Transform & world) {
 	
 }
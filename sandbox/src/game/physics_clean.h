@@ -4,6 +4,8 @@
 namespace sandbox {
 
 void ecs_init_physics_clean(void);
-void ecs_update_physics_clean(r32 dt);
+// @Note: `prepare` runs once per frame ahead of `update`, which might be split into chunks
+void ecs_prepare_physics_clean(r32 dt);
+void ecs_update_physics_clean(u32 chunk, u32 chunks_count);
 
 }
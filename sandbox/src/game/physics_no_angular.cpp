@@ -4,6 +4,7 @@
 #include "engine/api/internal/asset_types.h"
 #include "engine/impl/array.h"
 #include "engine/impl/reference.h"
+#include "engine/impl/entity_system.h"
 #include "engine/impl/math_linear.h"
 
 #include "../entity_system/component_types.h"
@@ -12,7 +13,7 @@ namespace {
 
 struct Entity_Blob {
 	custom::Entity   entity;
-	Transform      * transform;
+	Transform        world;
 	Phys2d         * physical;
 };
 
@@ -72,7 +73,7 @@ namespace sandbox {
 static custom::Asset_RefT<custom::Config_Asset> config_ref = {custom::empty_ref, custom::empty_index};
 void ecs_init_physics_no_angular(void) {
 	u32 config_id = custom::Asset::get_id("assets/configs/client.cfg", custom::empty_index);
-	config_ref = custom::Asset::add<custom::Config_Asset>(config_id);
+	config_ref.assign(custom::Asset::add<custom::Config_Asset>(config_id));
 }
 
 static void consume_config(void) {
@@ -99,22 +100,19 @@ void ecs_update_physics_no_angular(r32 dt) {
 	CUSTOM_ASSERT(settings.frequency, "zero frequency");
 	r32 period = 1.0f / settings.frequency;
 
+	// @Note: bodies are simulated in world space, whatever their hierarchy is
+	Transform_Cache::update();
+
 	//
 	custom::Array<Entity_Blob> entities(8);
-	for (u32 i = 0; i < custom::Entity::state.instances.count; ++i) {
-		custom::Entity entity = custom::Entity::state.instances[i];
-		if (!entity.exists()) { continue; }
-
-		Transform * transform = entity.get_component<Transform>().get_safe();
-		if (!transform) { continue; }
+	custom::Entity::query<Transform, Phys2d>([&](custom::Entity entity, Transform *, Phys2d * physical) {
+		if (!physical->mesh.exists()) { CUSTOM_ASSERT(false, "no mesh data"); return; }
+		if (physical->mesh.is_pending() || physical->mesh.is_failed()) { return; }
 
-		Phys2d * physical = entity.get_component<Phys2d>().get_safe();
-		if (!physical) { continue; }
-		if (!physical->mesh.exists()) { CUSTOM_ASSERT(false, "no mesh data"); continue; }
-
-		CUSTOM_ASSERT(!quat_is_singularity(transform->rotation), "verify your code");
-		entities.push({entity, transform, physical});
-	}
+		Transform const * world = Transform_Cache::get_transform(entity);
+		CUSTOM_ASSERT(!quat_is_singularity(world->rotation), "verify your code");
+		entities.push({entity, *world, physical});
+	});
 
 	//
 	custom::Array<Physical_Blob> physicals(entities.count);
@@ -125,10 +123,10 @@ void ecs_update_physics_no_angular(r32 dt) {
 		Physical_Blob * blob = physicals.data + (physicals.count - 1);
 
 		//
-		blob->position = entity.transform->position.xy;
-		blob->scale    = entity.transform->scale.xy;
+		blob->position = entity.world.position.xy;
+		blob->scale    = entity.world.scale.xy;
 		blob->rotation = complex_from_radians(
-			quat_get_radians_z(entity.transform->rotation)
+			quat_get_radians_z(entity.world.rotation)
 		);
 
 		//
@@ -155,11 +153,15 @@ void ecs_update_physics_no_angular(r32 dt) {
 	for (u32 i = 0; i < entities.count; ++i) {
 		Physical_Blob const & physical = physicals[i];
 		Entity_Blob         & entity   = entities[i];
+		// @Note: keep static bodies' change versions intact
+		if (!physical.movable) { continue; }
+		entity.entity.get_component<Phys2d>().touch();
 		//
-		entity.transform->position.xy = physical.position;
-		entity.transform->rotation = quat_from_radians({
+		entity.world.position.xy = physical.position;
+		entity.world.rotation = quat_from_radians({
 			0, 0, complex_get_radians(physical.rotation)
 		});
+		Transform_Cache::set_transform(entity.entity, entity.world);
 		//
 		entity.physical->velocity = physical.velocity;
 		entity.physical->acceleration = {0, 0};
@@ -230,9 +232,6 @@ static void ecs_update_physics_iteration(r32 dt, custom::Array<Physical_Blob> &
 
 	// @Todo: broad phase; at least, global AABB for the time being
 
-	// @Todo: process in local space?
-	//        - until then, apply whole hierarchy transform?
-	//        - allow only local space?
 	transformed_points.count = 0;
 	transformed_points_buffer.count = 0;
 	for (u32 i = 0; i < physicals.count; ++i) {
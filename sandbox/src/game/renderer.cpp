@@ -5,6 +5,7 @@
 #include "engine/api/internal/entity_system.h"
 #include "engine/api/internal/application.h"
 #include "engine/impl/array.h"
+#include "engine/impl/entity_system.h"
 #include "engine/impl/math_linear.h"
 
 #include "../entity_system/component_types.h"
@@ -18,25 +19,24 @@
 
 namespace {
 
-struct Transforms_Blob {
-	custom::Entity    entity;
-	Transform const * transform;
-};
-
 struct Renderer_Blob {
-	u32            id;
+	mat4 const   * transform;
 	Camera const * camera;
 };
 
 struct Renderable_Blob {
-	u32            id;
+	mat4 const   * transform;
 	Visual const * visual;
 };
 
 }
 
-static void build_transforms_map(custom::Array<Transform> & id_to_transform);
-static void ecs_update_renderer_internal(custom::Array<Transform> const & id_to_transform, custom::Array<Renderer_Blob> const & renderers, custom::Array<Renderable_Blob> const & renderables);
+static void ecs_update_renderer_internal(custom::Array<Renderer_Blob> const & renderers, custom::Array<Renderable_Blob> const & renderables);
+
+template<typename T>
+inline static bool is_loaded(custom::Asset_RefT<T> const & asset) {
+	return !asset.is_pending() && !asset.is_failed();
+}
 
 //
 //
@@ -45,34 +45,21 @@ static void ecs_update_renderer_internal(custom::Array<Transform> const & id_to_
 namespace sandbox {
 
 void ecs_update_renderer(void) {
-	custom::Array<Transform> id_to_transform;
-	build_transforms_map(id_to_transform);
+	Transform_Cache::update();
 
 	custom::Array<Renderer_Blob> renderers(8);
-	for (u32 i = 0; i < custom::Entity::state.instances.count; ++i) {
-		custom::Entity const entity = custom::Entity::state.instances[i];
-		if (!entity.exists()) { continue; }
-		if (!entity.has_component<Transform>()) { continue; }
-
-		Camera const * camera = entity.get_component<Camera>().get_safe();
-		if (!camera) { continue; }
-
-		renderers.push({entity.id, camera});
-	}
-
-	custom::Array<Renderable_Blob> renderables(custom::Entity::state.instances.count);
-	for (u32 i = 0; i < custom::Entity::state.instances.count; ++i) {
-		custom::Entity const entity = custom::Entity::state.instances[i];
-		if (!entity.exists()) { continue; }
-		if (!entity.has_component<Transform>()) { continue; }
-
-		Visual const * visual = entity.get_component<Visual>().get_safe();
-		if (!visual) { continue; }
+	custom::Entity::query<Transform, Camera>([&](custom::Entity entity, Transform const *, Camera const * camera) {
+		renderers.push({Transform_Cache::get_matrix(entity), camera});
+	});
 
-		renderables.push({entity.id, visual});
-	}
+	custom::Array<Renderable_Blob> renderables(custom::Entity::world->instances.count);
+	custom::Entity::query<Transform, Visual>([&](custom::Entity entity, Transform const *, Visual const * visual) {
+		// @Note: skip visuals with assets still being loaded or failed to
+		if (!is_loaded(visual->shader) || !is_loaded(visual->texture) || !is_loaded(visual->mesh)) { return; }
+		renderables.push({Transform_Cache::get_matrix(entity), visual});
+	});
 
-	ecs_update_renderer_internal(id_to_transform, renderers, renderables);
+	ecs_update_renderer_internal(renderers, renderables);
 }
 
 }
@@ -81,47 +68,7 @@ void ecs_update_renderer(void) {
 //
 //
 
-static void build_transforms_map(custom::Array<Transform> & id_to_transform) {
-	custom::Array<Transforms_Blob> transforms(custom::Entity::state.instances.count);
-	for (u32 i = 0; i < custom::Entity::state.instances.count; ++i) {
-		custom::Entity const entity = custom::Entity::state.instances[i];
-		if (!entity.exists()) { continue; }
-
-		Transform const * transform = entity.get_component<Transform>().get_safe();
-		if (!transform) { continue; }
-
-		transforms.push({entity, transform});
-	}
-	// transforms.set_capacity(transforms.count);
-
-	// @Todo: use actual map structure?
-	//        be more optimal fetching parents?
-	u32 transform_ids_limit = 0;
-	for (u32 i = 0; i < transforms.count; ++i) {
-		transform_ids_limit = max(transform_ids_limit, transforms[i].entity.id);
-	}
-
-	id_to_transform.set_capacity(transform_ids_limit + 1);
-	for (u32 i = 0; i < transforms.count; ++i) {
-		Transforms_Blob const & transform = transforms[i];
-		id_to_transform.get(transform.entity.id) = *transform.transform;
-	}
-
-	for (u32 i = 0; i < transforms.count; ++i) {
-		Transforms_Blob const & transform = transforms[i];
-
-		Hierarchy const * hierarchy = transform.entity.get_component<Hierarchy>().get_safe();
-		if (!hierarchy) { continue; }
-		if (!hierarchy->parent.exists()) { continue; }
-		if (!hierarchy->parent.has_component<Transform>()) { continue; }
-
-		Transform       & child  = id_to_transform.get(transform.entity.id);
-		Transform const & parent = id_to_transform.get(hierarchy->parent.id);
-		child = parent.transform(child);
-	}
-}
-
-static void ecs_update_renderer_internal(custom::Array<Transform> const & id_to_transform, custom::Array<Renderer_Blob> const & renderers, custom::Array<Renderable_Blob> const & renderables) {
+static void ecs_update_renderer_internal(custom::Array<Renderer_Blob> const & renderers, custom::Array<Renderable_Blob> const & renderables) {
 	static u32 const u_Resolution      = custom::uniform_names.store_string("u_Resolution", custom::empty_index);
 	static u32 const u_View_Projection = custom::uniform_names.store_string("u_View_Projection", custom::empty_index);
 	static u32 const u_Transform       = custom::uniform_names.store_string("u_Transform", custom::empty_index);
@@ -154,7 +101,7 @@ static void ecs_update_renderer_internal(custom::Array<Transform> const & id_to_
 
 		mat4 const camera_matrix = mat_transform(
 			renderer.camera->to_matrix(aspect),
-			mat_inverse_transform(id_to_transform.get(renderer.id).to_matrix())
+			mat_inverse_transform(*renderer.transform)
 		);
 
 		u32 last_renderable_i = renderable_i;
@@ -178,7 +125,7 @@ static void ecs_update_renderer_internal(custom::Array<Transform> const & id_to_
 		for (; renderable_i < last_renderable_i; ++renderable_i) {
 			Renderable_Blob const & renderable = renderables[renderable_i];
 
-			mat4 const transform_matrix = id_to_transform.get(renderable.id).to_matrix();
+			mat4 const & transform_matrix = *renderable.transform;
 
 			if (shader_id != renderable.visual->shader.ref.id) {
 				shader_id = renderable.visual->shader.ref.id;
@@ -59,10 +59,20 @@ static int Lua_Asset_eq(lua_State * L) {
 	return 1;
 }
 
+static int Lua_Asset_gc(lua_State * L) {
+	typedef custom::Asset_RefT<Lua_Asset> Asset_Ref;
+
+	Asset_Ref const * object = (Asset_Ref const *)lua_touserdata(L, 1);
+	object->release();
+
+	return 0;
+}
+
 static luaL_Reg const Lua_Asset_meta[] = {
 	{"__index", Lua_Asset_index},
 	{"__newindex", Lua_Asset_newindex},
 	{"__eq", Lua_Asset_eq},
+	{"__gc", Lua_Asset_gc},
 	// instance:###
 	// Type.###
 	//
@@ -10,6 +10,7 @@
 #include <lua.hpp>
 
 // @Todo: reuse userdata?
+// @Note: userdata might outlive a pool compaction, hence `relocate`
 
 //
 // Lua_Script
@@ -20,7 +21,8 @@ static int Lua_Script_index(lua_State * L) {
 
 	LUA_INDEX_RAWGET_IMPL(Lua_Script);
 
-	Ref const * object = (Ref const *)lua_touserdata(L, 1);
+	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
 
 	cstring id = lua_tostring(L, 2);
@@ -39,7 +41,9 @@ static int Lua_Script_newindex(lua_State * L) {
 	typedef custom::RefT<Lua_Script> Ref;
 
 	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
+	object->touch();
 
 	cstring id = lua_tostring(L, 2);
 
@@ -88,7 +92,8 @@ static int Visual_index(lua_State * L) {
 
 	LUA_INDEX_RAWGET_IMPL(Visual);
 
-	Ref const * object = (Ref const *)lua_touserdata(L, 1);
+	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
 
 	cstring id = lua_tostring(L, 2);
@@ -99,6 +104,7 @@ static int Visual_index(lua_State * L) {
 		Asset_Ref * udata = (Asset_Ref *)lua_newuserdatauv(L, sizeof(Asset_Ref), 0);
 		luaL_setmetatable(L, "Shader_Asset");
 		*udata = object->get_fast()->shader;
+		udata->acquire();
 		return 1;
 	}
 	
@@ -107,6 +113,7 @@ static int Visual_index(lua_State * L) {
 		Asset_Ref * udata = (Asset_Ref *)lua_newuserdatauv(L, sizeof(Asset_Ref), 0);
 		luaL_setmetatable(L, "Texture_Asset");
 		*udata = object->get_fast()->texture;
+		udata->acquire();
 		return 1;
 	}
 	
@@ -115,6 +122,7 @@ static int Visual_index(lua_State * L) {
 		Asset_Ref * udata = (Asset_Ref *)lua_newuserdatauv(L, sizeof(Asset_Ref), 0);
 		luaL_setmetatable(L, "Mesh_Asset");
 		*udata = object->get_fast()->mesh;
+		udata->acquire();
 		return 1;
 	}
 	
@@ -131,7 +139,9 @@ static int Visual_newindex(lua_State * L) {
 	typedef custom::RefT<Visual> Ref;
 
 	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
+	object->touch();
 
 	cstring id = lua_tostring(L, 2);
 
@@ -140,21 +150,21 @@ static int Visual_newindex(lua_State * L) {
 		typedef custom::Asset_RefT<custom::Shader_Asset> Asset_Ref;
 		LUA_ASSERT_USERDATA("Shader_Asset", 3);
 		Asset_Ref const * value = (Asset_Ref const *)lua_touserdata(L, 3);
-		object->get_fast()->shader = *value; return 0;
+		object->get_fast()->shader.assign(*value); return 0;
 	}
 
 	if (strcmp(id, "texture") == 0) {
 		typedef custom::Asset_RefT<custom::Texture_Asset> Asset_Ref;
 		LUA_ASSERT_USERDATA("Texture_Asset", 3);
 		Asset_Ref const * value = (Asset_Ref const *)lua_touserdata(L, 3);
-		object->get_fast()->texture = *value; return 0;
+		object->get_fast()->texture.assign(*value); return 0;
 	}
 
 	if (strcmp(id, "mesh") == 0) {
 		typedef custom::Asset_RefT<custom::Mesh_Asset> Asset_Ref;
 		LUA_ASSERT_USERDATA("Mesh_Asset", 3);
 		Asset_Ref const * value = (Asset_Ref const *)lua_touserdata(L, 3);
-		object->get_fast()->mesh = *value; return 0;
+		object->get_fast()->mesh.assign(*value); return 0;
 	}
 
 	if (strcmp(id, "layer") == 0) {
@@ -190,66 +200,6 @@ static luaL_Reg const Visual_meta[] = {
 	{NULL, NULL},
 };
 
-//
-// Physical
-//
-
-static int Physical_index(lua_State * L) {
-	typedef custom::RefT<Physical> Ref;
-
-	LUA_INDEX_RAWGET_IMPL(Physical);
-
-	Ref const * object = (Ref const *)lua_touserdata(L, 1);
-	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
-
-	cstring id = lua_tostring(L, 2);
-
-	// @Optimize?
-	// if (strcmp(id, "") == 0) { lua_pushnil(L); return 1; }
-
-	LUA_REPORT_INDEX();
-	lua_pushnil(L); return 1;
-}
-
-static int Physical_newindex(lua_State * L) {
-	typedef custom::RefT<Physical> Ref;
-
-	Ref * object = (Ref *)lua_touserdata(L, 1);
-	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
-
-	cstring id = lua_tostring(L, 2);
-
-	// @Optimize?
-	// if (strcmp(id, "") == 0) { return 0;}
-
-	LUA_REPORT_INDEX();
-	return 0;
-}
-
-static int Physical_eq(lua_State * L) {
-	typedef custom::RefT<Physical> Ref;
-
-	CUSTOM_LUA_ASSERT(lua_gettop(L) == 2, "expected 2 arguments");
-	LUA_ASSERT_USERDATA("Physical", 2);
-
-	Ref const * object1 = (Ref const *)lua_touserdata(L, 1);
-	Ref const * object2 = (Ref const *)lua_touserdata(L, 2);
-
-	lua_pushboolean(L, *object1 == *object2);
-
-	return 1;
-}
-
-static luaL_Reg const Physical_meta[] = {
-	{"__index", Physical_index},
-	{"__newindex", Physical_newindex},
-	{"__eq", Physical_eq},
-	// instance:###
-	// Type.###
-	//
-	{NULL, NULL},
-};
-
 //
 // Phys2d
 //
@@ -259,7 +209,8 @@ static int Phys2d_index(lua_State * L) {
 
 	LUA_INDEX_RAWGET_IMPL(Phys2d);
 
-	Ref const * object = (Ref const *)lua_touserdata(L, 1);
+	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
 
 	cstring id = lua_tostring(L, 2);
@@ -280,6 +231,7 @@ static int Phys2d_index(lua_State * L) {
 		Asset_Ref * udata = (Asset_Ref *)lua_newuserdatauv(L, sizeof(Asset_Ref), 0);
 		luaL_setmetatable(L, "Collider2d_Asset");
 		*udata = object->get_fast()->mesh;
+		udata->acquire();
 		return 1;
 	}
 
@@ -308,7 +260,9 @@ static int Phys2d_newindex(lua_State * L) {
 	typedef custom::RefT<Phys2d> Ref;
 
 	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
+	object->touch();
 
 	cstring id = lua_tostring(L, 2);
 
@@ -327,7 +281,7 @@ static int Phys2d_newindex(lua_State * L) {
 		typedef custom::Asset_RefT<custom::Collider2d_Asset> Asset_Ref;
 		LUA_ASSERT_USERDATA("Collider2d_Asset", 3);
 		Asset_Ref const * value = (Asset_Ref const *)lua_touserdata(L, 3);
-		object->get_fast()->mesh = *value; return 0;
+		object->get_fast()->mesh.assign(*value); return 0;
 	}
 
 	if (strcmp(id, "acceleration") == 0) {
@@ -373,6 +327,7 @@ static int Phys2d_add_impulse(lua_State * L) {
 	LUA_ASSERT_USERDATA("vec2", 2);
 
 	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
 
 	vec2 const * value = (vec2 const *)lua_touserdata(L, 2);
@@ -389,6 +344,7 @@ static int Phys2d_add_force(lua_State * L) {
 	LUA_ASSERT_USERDATA("vec2", 2);
 
 	Ref * object = (Ref *)lua_touserdata(L, 1);
+	object->relocate();
 	CUSTOM_LUA_ASSERT(object->exists(), "object doesn't exist");
 
 	vec2 const * value = (vec2 const *)lua_touserdata(L, 2);
@@ -418,6 +374,7 @@ namespace lua {
 
 void init_client_component_types(lua_State * L) {
 	#define COMPONENT_IMPL(T) LUA_META_IMPL(T)
+	#define TAG_IMPL(T) LUA_TAG_IMPL(T)
 	#include "../registry_impl/component_types.h"
 }
 
@@ -1,8 +1,10 @@
 #include "custom_engine.h"
 
 #include "engine/impl/asset_system.h"
+#include "engine/impl/entity_system.h"
 
 #include "asset_system/asset_types.h"
+#include "entity_system/component_types.h"
 
 #include "game/lua_runner.h"
 // #include "game/physics_no_angular.h"
@@ -55,6 +57,27 @@ static void consume_config(void) {
 	update_lua_callback = config->get_value<cstring>("update_lua_callback", "global_update");
 }
 
+static SYSTEM_FUNC(system_lua) {
+	sandbox::lua_function(L, update_lua_callback);
+	sandbox::ecs_update_lua(L, dt);
+}
+
+// @Note: counts fixed steps and brings world transforms up to date for the chunks
+static SYSTEM_FUNC(system_physics_prepare) {
+	sandbox::ecs_prepare_physics_clean(dt);
+}
+
+static SYSTEM_FUNC(system_physics) {
+	// @Note: these solve all the bodies at once, so set the system's `chunks` to 1
+	// sandbox::ecs_update_physics_no_angular(dt);
+	// sandbox::ecs_update_physics_with_angular(dt);
+	sandbox::ecs_update_physics_clean(chunk, chunks_count);
+}
+
+static SYSTEM_FUNC(system_renderer) {
+	sandbox::ecs_update_renderer();
+}
+
 void init_client_asset_types(void);
 void init_client_component_types(void);
 void init_uniform_names(void);
@@ -67,7 +90,7 @@ static void on_app_init() {
 
 	// @Note init configs
 	u32 config_id = custom::Asset::store_string("assets/configs/client.cfg", custom::empty_index);
-	config_ref = custom::Asset::add<custom::Config_Asset>(config_id);
+	config_ref.assign(custom::Asset::add<custom::Config_Asset>(config_id));
 
 	consume_config_init();
 	consume_config();
@@ -83,6 +106,7 @@ static void on_app_init() {
 	custom::lua::init_math_linear(L);
 	custom::lua::init_asset_system(L);
 	custom::lua::init_entity_system(L);
+	custom::lua::init_scene_streaming(L);
 
 	// luaL_openlibs(lua);
 	luaL_requiref(L, LUA_GNAME, luaopen_base, 1); lua_pop(L, 1);
@@ -97,6 +121,21 @@ static void on_app_init() {
 	// sandbox::ecs_init_physics_with_angular();
 	sandbox::ecs_init_physics_clean();
 
+	// @Note: Lua scripts write transforms, bodies and cameras, changing structure immediately,
+	//        which is fine while everything else touches transforms; renderer writes graphics bytecode;
+	//        each system depends on the previous one's writes, so every one of them gets a stage
+	//        of its own, and main thread ones don't overlap with the chunked physics yet
+	u64 const lua_reads          = custom::Entity::make_signature<Lua_Script>();
+	u64 const lua_writes         = custom::Entity::make_signature<Transform, Phys2d, Camera>();
+	u64 const physics_signature  = custom::Entity::make_signature<Transform, Phys2d>();
+	u64 const prepare_reads      = custom::Entity::make_signature<Transform, Hierarchy, Phys2d>();
+	u64 const renderer_signature = custom::Entity::make_signature<Transform, Hierarchy, Camera, Visual>();
+	u32 const physics_chunks     = custom::thread::get_workers_count() + 1;
+	custom::scheduler::add_system({&system_lua,             lua_reads | lua_writes, lua_writes,        1,              true});
+	custom::scheduler::add_system({&system_physics_prepare, prepare_reads,          physics_signature, 1,              true});
+	custom::scheduler::add_system({&system_physics,         physics_signature,      physics_signature, physics_chunks, false});
+	custom::scheduler::add_system({&system_renderer,        renderer_signature,     0,                 1,              true});
+
 	// @Note: call Lua init
 	sandbox::lua_function(L, init_lua_callback);
 }
@@ -107,12 +146,7 @@ static void on_app_viewport(ivec2 size) {
 
 static void on_app_update(r32 dt) {
 	consume_config();
-	sandbox::lua_function(L, update_lua_callback);
-	sandbox::ecs_update_lua(L, dt);
-	// sandbox::ecs_update_physics_no_angular(dt);
-	// sandbox::ecs_update_physics_with_angular(dt);
-	sandbox::ecs_update_physics_clean(dt);
-	sandbox::ecs_update_renderer();
+	custom::scheduler::update(dt);
 
 	if (custom::application::get_key(custom::Key_Code::Alt) && custom::application::get_key_transition(custom::Key_Code::F4, true)) {
 		custom::system::should_close = true;
@@ -1,9 +1,14 @@
 // @Note: utility for automatic registration of component types:
 //        - #define a COMPONENT_IMPL(T) macro
+//        - #define a TAG_IMPL(T) macro, optionally; tags have no data and no pool,
+//          only a bit of the entity signature
 //        - #include this file
 COMPONENT_IMPL(Visual)
 COMPONENT_IMPL(Lua_Script)
-COMPONENT_IMPL(Physical)
 COMPONENT_IMPL(Phys2d)
 //
+#if defined(TAG_IMPL)
+TAG_IMPL(Physical)
+#undef TAG_IMPL
+#endif
 #undef COMPONENT_IMPL